@@ -0,0 +1,151 @@
+#ifndef CARRAY_H_202610192010
+#define CARRAY_H_202610192010
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* {{{
+ * =============================================================================
+ *      Filename    :   carray.h
+ *      Description :   元素直接存放在数组中的 vector
+ *
+ *          cvector 保存的是 void*, 每个元素都要单独分配. carray 按
+ *          elem_size 把元素连续存放, 插入时复制元素的内容, 元素不是 cobj,
+ *          删除时也不会释放. 接口与 cvector 一致, 但 at / pobj 返回的是
+ *          指向数组中元素的指针, 在数组增长后失效.
+ *
+ *          CARRAY_DECLARE(rec_array, rec_t)
+ *
+ *          会生成 rec_array_init / rec_array_append / rec_array_get /
+ *          rec_array_at ... 等带类型的 static inline 接口.
+ *      Created     :   2026-10-19 20:10:37
+ *      Author      :   Wu Hong
+ * =============================================================================
+ }}} */
+
+#include <stdlib.h>
+#include <stdbool.h>
+
+typedef struct carray
+{
+    unsigned int elem_size;
+    unsigned int size_alloc;
+    unsigned int size_offset;
+    char *data;
+}carray;
+
+typedef struct carray_iter
+{
+    carray *a;
+    int i;
+}carray_iter;
+
+#define CARRAY_ELEM(a, i) ((void*)((a)->data + (size_t)(i) * (a)->elem_size))
+
+/*
+ * 按顺序遍历, elem_ptr 为 type*
+ */
+#define carray_foreach(a, type, elem_ptr)                                     \
+    for(elem_ptr = (type*)(a)->data;                                          \
+        elem_ptr < (type*)(a)->data + (a)->size_offset;                       \
+        ++elem_ptr)
+
+void carray_iter_init(carray_iter *iter, carray *a, int i);
+bool carray_iter_is_end(const carray_iter *iter);
+bool carray_iter_is_rend(const carray_iter *iter);
+void* carray_iter_pobj(carray_iter *iter);
+carray_iter carray_iter_next(const carray_iter *iter);
+void carray_iter_to_next(carray_iter *iter);
+carray_iter carray_iter_prev(const carray_iter *iter);
+void carray_iter_to_prev(carray_iter *iter);
+
+void carray_init(carray *a, unsigned int elem_size);    /* 不分配内存 */
+void carray_release(carray *a);
+carray* carray_new(unsigned int elem_size);
+void carray_free(carray *a);
+void carray_clear(carray *a);
+bool carray_is_empty(const carray *a);
+int  carray_length(const carray *a);
+int  carray_size(const carray *a);
+unsigned int carray_capacity(const carray *a);
+bool carray_reserve(carray *a, unsigned int capacity);
+void carray_shrink_to_fit(carray *a);
+
+void carray_insert(carray *a, int i, const void *elem);
+void carray_insert_range(carray *a, int i, const void *elems, int n);
+void carray_append(carray *a, const void *elem);
+void carray_append_array(carray *a, const void *elems, int n);
+void carray_prepend(carray *a, const void *elem);
+void* carray_emplace_back(carray *a);   /* 追加一个未初始化的元素, 返回其指针 */
+bool carray_pop_at(carray *a, int i, void *elem);   /* elem 可以为 NULL */
+bool carray_pop_front(carray *a, void *elem);
+bool carray_pop_back(carray *a, void *elem);
+void* carray_at(carray *a, int i);
+void* carray_at_first(carray *a);
+void* carray_at_last(carray *a);
+void carray_replace(carray *a, int i, const void *elem);
+carray_iter carray_begin(carray *a);
+carray_iter carray_end(carray *a);
+carray_iter carray_rbegin(carray *a);
+carray_iter carray_rend(carray *a);
+
+void carray_remove(carray_iter *iter);
+void carray_remove_at(carray *a, int i);
+void carray_remove_at_range(carray *a, int first, int last);
+
+#define CARRAY_DECLARE(name, type)                                            \
+                                                                              \
+static inline void name##_init(carray *a)                                     \
+{                                                                             \
+    carray_init(a, sizeof(type));                                             \
+}                                                                             \
+                                                                              \
+static inline carray* name##_new(void)                                        \
+{                                                                             \
+    return carray_new(sizeof(type));                                          \
+}                                                                             \
+                                                                              \
+static inline type* name##_data(carray *a)                                    \
+{                                                                             \
+    return (type*)a->data;                                                    \
+}                                                                             \
+                                                                              \
+/* 不检查下标 */                                                              \
+static inline type name##_get(const carray *a, int i)                         \
+{                                                                             \
+    return ((const type*)a->data)[i];                                         \
+}                                                                             \
+                                                                              \
+static inline void name##_set(carray *a, int i, type val)                     \
+{                                                                             \
+    ((type*)a->data)[i] = val;                                                \
+}                                                                             \
+                                                                              \
+static inline type* name##_at(carray *a, int i)                               \
+{                                                                             \
+    return (type*)carray_at(a, i);                                            \
+}                                                                             \
+                                                                              \
+static inline void name##_append(carray *a, type val)                         \
+{                                                                             \
+    if(a->size_offset < a->size_alloc) {                                      \
+        ((type*)a->data)[a->size_offset++] = val;                             \
+    } else {                                                                  \
+        carray_append(a, &val);                                               \
+    }                                                                         \
+}                                                                             \
+                                                                              \
+static inline void name##_insert(carray *a, int i, type val)                  \
+{                                                                             \
+    carray_insert(a, i, &val);                                                \
+}                                                                             \
+                                                                              \
+static inline bool name##_pop_back(carray *a, type *val)                      \
+{                                                                             \
+    return carray_pop_back(a, val);                                           \
+}
+
+#ifdef __cplusplus
+}
+#endif
+#endif  /* CARRAY_H_202610192010 */
@@ -0,0 +1,45 @@
+#ifndef CBQUEUE_H_202610191745
+#define CBQUEUE_H_202610191745
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* {{{
+ * =============================================================================
+ *      Filename    :   cbqueue.h
+ *      Description :   基于 csem 的有界阻塞队列
+ *
+ *          队列满时 push 阻塞生产者, 队列空时 pop 阻塞消费者.
+ *          pop_batch 每次唤醒最多取走 max_n 个元素, 减少唤醒次数.
+ *          元素不能为 NULL.
+ *      Created     :   2026-10-19 17:45:20
+ *      Author      :   Wu Hong
+ * =============================================================================
+ }}} */
+
+#include <stdlib.h>
+#include <stdbool.h>
+
+typedef struct cbqueue cbqueue;
+
+cbqueue* cbqueue_new(unsigned int capacity);
+void cbqueue_free(cbqueue *queue);      /* 剩余的元素使用 cobj_free 释放 */
+
+unsigned int cbqueue_capacity(const cbqueue *queue);
+unsigned int cbqueue_size(cbqueue *queue);
+
+void  cbqueue_push(cbqueue *queue, void *obj);
+bool  cbqueue_try_push(cbqueue *queue, void *obj);
+void* cbqueue_pop(cbqueue *queue);
+void* cbqueue_try_pop(cbqueue *queue);
+void* cbqueue_pop_timed(cbqueue *queue, int msec);  /* 超时返回 NULL */
+
+/*
+ * 阻塞直到至少有一个元素, 然后取走最多 max_n 个, 返回取走的个数
+ */
+unsigned int cbqueue_pop_batch(cbqueue *queue, void **objs, unsigned int max_n);
+
+#ifdef __cplusplus
+}
+#endif
+#endif  /* CBQUEUE_H_202610191745 */
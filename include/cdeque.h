@@ -0,0 +1,73 @@
+#ifndef CDEQUE_H_202610191930
+#define CDEQUE_H_202610191930
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* {{{
+ * =============================================================================
+ *      Filename    :   cdeque.h
+ *      Description :   双端队列
+ *
+ *          基于大小为 2 的幂的环形数组, 两端的 append / prepend / pop 以及
+ *          按下标访问都是 O(1). 迭代器的用法与 cvector_iter 相同.
+ *      Created     :   2026-10-19 19:30:12
+ *      Author      :   Wu Hong
+ * =============================================================================
+ }}} */
+
+#include "cobj.h"
+
+typedef struct cdeque
+{
+    unsigned int size_alloc;    /* 0 或 2 的幂 */
+    unsigned int size_offset;
+    unsigned int head;          /* 第一个元素在 objs 中的位置 */
+    void **objs;
+}cdeque;
+
+typedef struct cdeque_iter
+{
+    cdeque *dq;
+    int i;
+}cdeque_iter;
+
+void cdeque_iter_init(cdeque_iter *iter, cdeque *dq, int i);
+bool cdeque_iter_is_end(const cdeque_iter *iter);
+bool cdeque_iter_is_rend(const cdeque_iter *iter);
+void* cdeque_iter_pobj(cdeque_iter *iter);
+cdeque_iter cdeque_iter_next(const cdeque_iter *iter);
+void cdeque_iter_to_next(cdeque_iter *iter);
+cdeque_iter cdeque_iter_prev(const cdeque_iter *iter);
+void cdeque_iter_to_prev(cdeque_iter *iter);
+
+void cdeque_init(cdeque *dq);       /* 不分配内存 */
+void cdeque_release(cdeque *dq);
+cdeque* cdeque_new(void);
+cdeque* cdeque_new_with_capacity(unsigned int capacity);
+void cdeque_free(cdeque *dq);
+void cdeque_clear(cdeque *dq);
+bool cdeque_is_empty(const cdeque *dq);
+int  cdeque_length(const cdeque *dq);
+int  cdeque_size(const cdeque *dq);
+unsigned int cdeque_capacity(const cdeque *dq);
+bool cdeque_reserve(cdeque *dq, unsigned int capacity);
+void cdeque_print(const cdeque *dq);
+
+void cdeque_append(cdeque *dq, void *obj);
+void cdeque_prepend(cdeque *dq, void *obj);
+void* cdeque_pop_front(cdeque *dq);
+void* cdeque_pop_back(cdeque *dq);
+void* cdeque_at(cdeque *dq, int i);     /* 负数表示从末尾开始 */
+void* cdeque_at_first(cdeque *dq);
+void* cdeque_at_last(cdeque *dq);
+void cdeque_replace(cdeque *dq, int i, void *obj);
+cdeque_iter cdeque_begin(cdeque *dq);
+cdeque_iter cdeque_end(cdeque *dq);
+cdeque_iter cdeque_rbegin(cdeque *dq);
+cdeque_iter cdeque_rend(cdeque *dq);
+
+#ifdef __cplusplus
+}
+#endif
+#endif  /* CDEQUE_H_202610191930 */
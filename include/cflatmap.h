@@ -0,0 +1,68 @@
+#ifndef CFLATMAP_H_202610200012
+#define CFLATMAP_H_202610200012
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* {{{
+ * =============================================================================
+ *      Filename    :   cflatmap.h
+ *      Description :   有序的扁平 map
+ *
+ *          key 和 value 分别按 key 的顺序连续存放在两个 cvector 中, 每个元素
+ *          只占两个指针, 适合一次建立, 多次查找的表. 查找为无分支的二分查找,
+ *          插入和删除为 O(n), 批量插入请使用 cflatmap_merge.
+ *          cmp 为 NULL 时使用 cobj_cmp, key 和 value 的所有权属于 map.
+ *      Created     :   2026-10-20 00:12:37
+ *      Author      :   Wu Hong
+ * =============================================================================
+ }}} */
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include "cobj.h"
+#include "cvector.h"
+
+typedef struct cflatmap cflatmap;
+
+cflatmap* cflatmap_new(cobj_cb_cmp cmp);
+/*
+ * 由未排序的 keys[i] / vals[i] 批量创建, O(n log n). 所有权转移给 map,
+ * 重复的 key 以后出现的为准. keys / vals 数组会被重新排列.
+ * 失败时返回 NULL, 所有权不转移.
+ */
+cflatmap* cflatmap_build_from(void **keys, void **vals, size_t n, cobj_cb_cmp cmp);
+void cflatmap_free(cflatmap *map);
+void cflatmap_clear(cflatmap *map);
+void cflatmap_print(const cflatmap *map);
+
+bool   cflatmap_is_empty(const cflatmap *map);
+size_t cflatmap_size(const cflatmap *map);
+
+/*
+ * key 已存在时替换, 旧的 key 和 value 被释放 (传入的就是已存放的对象时保留).
+ * 失败时返回 false, 所有权不转移
+ */
+bool cflatmap_set(cflatmap *map, void *key, void *val);
+/*
+ * 批量插入 n 个未排序的 key / value, O(n log n + size), 规则与
+ * cflatmap_build_from 相同, 与 map 中已有的 key 重复时以新的为准.
+ */
+bool cflatmap_merge(cflatmap *map, void **keys, void **vals, size_t n);
+void cflatmap_del(cflatmap *map, const void *key);
+
+bool  cflatmap_haskey(const cflatmap *map, const void *key);
+void* cflatmap_get_value(const cflatmap *map, const void *key);
+
+/*
+ * 按下标访问, 下标的顺序即 key 的顺序
+ */
+ssize_t cflatmap_find(const cflatmap *map, const void *key);    /* 不存在时返回 -1 */
+size_t  cflatmap_lower_bound(const cflatmap *map, const void *key);
+void*   cflatmap_key_at(const cflatmap *map, size_t i);          /* 越界时返回 NULL */
+void*   cflatmap_value_at(const cflatmap *map, size_t i);
+
+#ifdef __cplusplus
+}
+#endif
+#endif  /* CFLATMAP_H_202610200012 */
@@ -24,11 +24,21 @@ extern "C" {
 typedef struct chash chash;
 typedef struct chash_iter chash_iter;
 
+typedef void (*chash_cb_foreach)(void *key, void *val, void *arg);
+typedef bool (*chash_cb_match)(const void *key, const void *val, void *arg);
+typedef void (*chash_cb_merge)(void *result, const void *acc);
+
 uint32_t hash_val(const uint8_t *key, uint32_t keylen);
 
 chash *chash_new(void);
 void chash_free(chash *hash);
 void chash_clear(chash *hash);
+/*
+ * O(1) 清空: 只递增 generation, 旧的 key/value 在桶下次被修改时才释放,
+ * 释放后的 item 和桶的链表节点 (来自 hash 表的节点池) 会被后续插入复用,
+ * 不再调用 free/malloc. 适合每个请求重复使用的 hash 表.
+ */
+void chash_reset(chash *hash);
 uint32_t chash_count(const chash *hash);
 bool chash_haskey(const chash *hash, const void *key);
 void chash_del(chash *hash, const void *key);
@@ -36,18 +46,49 @@ void* chash_get_value(chash *hash, const void *key);
 void chash_set(chash *hash, void *key, void *val);
 void chash_to_cstr(const chash *hash, cstr *str);
 
+/*
+ * 由 keys[i] / vals[i] 批量创建 hash 表, 按 n 预分配桶, 使用 nthreads 个线程
+ * 并行计算 hash 值并按桶区间分区填充. key 和 value 的所有权转移给 hash 表,
+ * 重复的 key 以后出现的为准.
+ */
+chash* chash_build_from(void **keys, void **vals, uint32_t n, int nthreads);
+
 #ifdef CHASH_ENABLE_SEM
 void chash_lock(chash *hash);
 void chash_unlock(chash *hash);
 #endif
 
 chash_iter* chash_iter_new(const chash *hash);
+/*
+ * 将桶划分为 nparts 个互不相交的区间, 返回第 part 个区间的迭代器,
+ * 不同区间的迭代器可以在不同线程中同时使用 (期间不能修改 hash 表)
+ * 要求 0 <= part < nparts, 否则返回 NULL
+ */
+chash_iter* chash_partition_iter(const chash *hash, int part, int nparts);
 void chash_iter_free(chash_iter *itor);
 bool chash_iter_is_end(chash_iter *itor);
 chash_iter* chash_iter_next(chash_iter *itor);
 void* chash_iter_key(chash_iter *itor);
 void* chash_iter_value(chash_iter *itor);
 
+/*
+ * 使用 nthreads 个线程按桶区间并行遍历, fn 会被并发调用
+ */
+void chash_parallel_for_each(const chash *hash, chash_cb_foreach fn,
+                             void *arg, int nthreads);
+/*
+ * 并行归约: result 中为初始值 (单位元), 每个线程从其副本开始以
+ * fn(key, val, acc) 累加, 结束后依次 fn_merge(result, acc) 合并
+ */
+void chash_parallel_reduce(const chash *hash, chash_cb_foreach fn,
+                           chash_cb_merge fn_merge, void *result,
+                           size_t result_size, int nthreads);
+/*
+ * 并行删除 fn 返回 true 的元素, 返回删除的个数
+ */
+uint32_t chash_parallel_remove_if(chash *hash, chash_cb_match fn,
+                                  void *arg, int nthreads);
+
 void chash_printf(const chash *hash, FILE *file);
 void chash_printf_test(const chash *hash, FILE *file);
 
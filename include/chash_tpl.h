@@ -0,0 +1,335 @@
+#ifndef CHASH_TPL_H_202610191010
+#define CHASH_TPL_H_202610191010
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* {{{
+ * =============================================================================
+ *      Filename    :   chash_tpl.h
+ *      Description :   类型特化的 hash 表生成器（参考 khash）
+ *
+ *          chash 的每次操作都要经过 cobj_hash / cobj_cmp 函数指针，key 和 value
+ *          也都是 void*。CHASH_DECLARE 按给定的 key/value 类型生成一整套
+ *          static inline 函数，key 和 value 直接存放在表内，hash 和比较函数
+ *          可以被编译器内联。
+ *
+ *          CHASH_DECLARE(u64map, uint64_t, rec_t,
+ *                        chash_tpl_hash_u64, chash_tpl_eq_scalar)
+ *
+ *          会生成类型 u64map 以及 u64map_new / u64map_set / u64map_get /
+ *          u64map_del / u64map_haskey / u64map_count ... 等接口。
+ *          采用开放寻址 + 线性探测，桶数量始终为 2 的幂。
+ *      Created     :   2026-10-19 10:10:21
+ *      Author      :   Wu Hong
+ * =============================================================================
+ }}} */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "murmurhash.h"
+
+#define CHASH_TPL_BKTS_MIN      16
+#define CHASH_TPL_BKTS_MAX      ((uint32_t)1 << 31)     /* 再翻倍会溢出 uint32_t */
+#define CHASH_TPL_LOAD_FACTOR   0.77
+
+#define CHASH_TPL_FLAG_EMPTY    0
+#define CHASH_TPL_FLAG_USED     1
+#define CHASH_TPL_FLAG_DELETED  2
+
+static inline uint32_t chash_tpl_hash_u32(uint32_t key)
+{
+    key ^= key >> 16;
+    key *= 0x85ebca6b;
+    key ^= key >> 13;
+    key *= 0xc2b2ae35;
+    key ^= key >> 16;
+
+    return key;
+}
+
+static inline uint32_t chash_tpl_hash_u64(uint64_t key)
+{
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    key *= 0xc4ceb9fe1a85ec53ULL;
+    key ^= key >> 33;
+
+    return (uint32_t)key;
+}
+
+static inline uint32_t chash_tpl_hash_str(const char *key)
+{
+    return murmurhash(key, strlen(key));
+}
+
+#define chash_tpl_eq_scalar(a, b)   ((a) == (b))
+#define chash_tpl_eq_str(a, b)      (strcmp((a), (b)) == 0)
+
+/*
+ * 遍历所有有效的槽位, idx 为 uint32_t
+ */
+#define chash_tpl_foreach(name, hash, idx)                                    \
+    for(idx = name##_begin(hash);                                             \
+        idx != name##_end(hash);                                              \
+        idx = name##_next(hash, idx))
+
+#define CHASH_DECLARE(name, key_type, val_type, hash_fn, eq_fn)               \
+                                                                              \
+typedef struct name                                                           \
+{                                                                             \
+    uint32_t bkts_num;                                                        \
+    uint32_t cnt_items;                                                       \
+    uint32_t cnt_used;      /* 有效 + 已删除的槽位 */                         \
+    uint32_t cnt_upper;     /* cnt_used 超过此值时重新调整 */                 \
+    uint8_t  *flags;                                                          \
+    key_type *keys;                                                           \
+    val_type *vals;                                                           \
+} name;                                                                       \
+                                                                              \
+static inline name* name##_new(void)                                          \
+{                                                                             \
+    return (name*)calloc(1, sizeof(name));                                    \
+}                                                                             \
+                                                                              \
+static inline void name##_release(name *hash)                                 \
+{                                                                             \
+    free(hash->flags);                                                        \
+    free(hash->keys);                                                         \
+    free(hash->vals);                                                         \
+    memset(hash, 0, sizeof(name));                                            \
+}                                                                             \
+                                                                              \
+static inline void name##_free(name *hash)                                    \
+{                                                                             \
+    if(hash) {                                                                \
+        name##_release(hash);                                                 \
+        free(hash);                                                           \
+    }                                                                         \
+}                                                                             \
+                                                                              \
+static inline void name##_clear(name *hash)                                   \
+{                                                                             \
+    if(hash->flags) {                                                         \
+        memset(hash->flags, CHASH_TPL_FLAG_EMPTY, hash->bkts_num);            \
+    }                                                                         \
+    hash->cnt_items = 0;                                                      \
+    hash->cnt_used  = 0;                                                      \
+}                                                                             \
+                                                                              \
+static inline uint32_t name##_count(const name *hash)                         \
+{                                                                             \
+    return hash->cnt_items;                                                   \
+}                                                                             \
+                                                                              \
+/* 返回 key 所在槽位, 不存在时返回 name##_end() */                            \
+static inline uint32_t name##_find(const name *hash, key_type key)            \
+{                                                                             \
+    uint32_t mask = 0;                                                        \
+    uint32_t idx  = 0;                                                        \
+    uint32_t step = 0;                                                        \
+                                                                              \
+    if(0 == hash->bkts_num) return 0;                                         \
+                                                                              \
+    mask = hash->bkts_num - 1;                                                \
+    idx  = (uint32_t)(hash_fn(key)) & mask;                                   \
+    while(hash->flags[idx] != CHASH_TPL_FLAG_EMPTY) {                         \
+        if(hash->flags[idx] == CHASH_TPL_FLAG_USED                            \
+        && eq_fn(hash->keys[idx], key)) {                                     \
+            return idx;                                                       \
+        }                                                                     \
+        idx = (idx + 1) & mask;                                               \
+        if(++step == hash->bkts_num) break;                                   \
+    }                                                                         \
+                                                                              \
+    return hash->bkts_num;                                                    \
+}                                                                             \
+                                                                              \
+/* 重新分配 bkts_num 个槽位 (2 的幂), 失败返回 false */                       \
+static inline bool name##_resize(name *hash, uint32_t bkts_num)               \
+{                                                                             \
+    uint8_t  *flags = NULL;                                                   \
+    key_type    *keys  = NULL;                                                \
+    val_type    *vals  = NULL;                                                \
+    uint32_t mask   = bkts_num - 1;                                           \
+    uint32_t i      = 0;                                                      \
+    uint32_t idx    = 0;                                                      \
+                                                                              \
+    flags = (uint8_t*)calloc(bkts_num, sizeof(uint8_t));                      \
+    keys  = (key_type*)malloc(sizeof(key_type) * bkts_num);                   \
+    vals  = (val_type*)malloc(sizeof(val_type) * bkts_num);                   \
+    if(NULL == flags || NULL == keys || NULL == vals) {                       \
+        free(flags); free(keys); free(vals);                                  \
+        return false;                                                         \
+    }                                                                         \
+                                                                              \
+    for(i = 0; i < hash->bkts_num; ++i) {                                     \
+        if(hash->flags[i] != CHASH_TPL_FLAG_USED) continue;                   \
+                                                                              \
+        idx = (uint32_t)(hash_fn(hash->keys[i])) & mask;                      \
+        while(flags[idx] != CHASH_TPL_FLAG_EMPTY) {                           \
+            idx = (idx + 1) & mask;                                           \
+        }                                                                     \
+        flags[idx] = CHASH_TPL_FLAG_USED;                                     \
+        keys[idx]  = hash->keys[i];                                           \
+        vals[idx]  = hash->vals[i];                                           \
+    }                                                                         \
+                                                                              \
+    free(hash->flags);                                                        \
+    free(hash->keys);                                                         \
+    free(hash->vals);                                                         \
+    hash->flags     = flags;                                                  \
+    hash->keys      = keys;                                                   \
+    hash->vals      = vals;                                                   \
+    hash->bkts_num  = bkts_num;                                               \
+    hash->cnt_used  = hash->cnt_items;                                        \
+    hash->cnt_upper = (uint32_t)(bkts_num * CHASH_TPL_LOAD_FACTOR);           \
+                                                                              \
+    return true;                                                              \
+}                                                                             \
+                                                                              \
+/* 预留可容纳 cnt 个元素的空间, 超过 CHASH_TPL_BKTS_MAX 的容量时返回 false */ \
+static inline bool name##_reserve(name *hash, uint32_t cnt)                   \
+{                                                                             \
+    uint32_t bkts_num = CHASH_TPL_BKTS_MIN;                                   \
+                                                                              \
+    if(cnt > (uint32_t)(CHASH_TPL_BKTS_MAX * CHASH_TPL_LOAD_FACTOR)) {        \
+        return false;                                                         \
+    }                                                                         \
+    while((uint32_t)(bkts_num * CHASH_TPL_LOAD_FACTOR) < cnt) {               \
+        bkts_num <<= 1;                                                       \
+    }                                                                         \
+    if(bkts_num <= hash->bkts_num) return true;                               \
+                                                                              \
+    return name##_resize(hash, bkts_num);                                     \
+}                                                                             \
+                                                                              \
+/*                                                                            \
+ * 查找或插入 key, 返回 value 槽位的指针, 失败返回 NULL                       \
+ * 新插入时 *is_new 为 true, 此时 value 未初始化                              \
+ */                                                                           \
+static inline val_type* name##_put(name *hash, key_type key, bool *is_new)    \
+{                                                                             \
+    uint32_t mask = 0;                                                        \
+    uint32_t idx  = 0;                                                        \
+    uint32_t tomb = 0;                                                        \
+    bool has_tomb = false;                                                    \
+                                                                              \
+    if(hash->cnt_used >= hash->cnt_upper) {                                   \
+        /* 删除标记过多时原地整理, 否则扩容 */                                \
+        uint32_t bkts_num = hash->bkts_num;                                   \
+        if(0 == bkts_num) {                                                   \
+            bkts_num = CHASH_TPL_BKTS_MIN;                                    \
+        } else if(hash->cnt_items * 2 >= hash->cnt_upper) {                   \
+            if(bkts_num >= CHASH_TPL_BKTS_MAX) return NULL;                   \
+            bkts_num <<= 1;                                                   \
+        }                                                                     \
+        if(!name##_resize(hash, bkts_num)) return NULL;                       \
+    }                                                                         \
+                                                                              \
+    mask = hash->bkts_num - 1;                                                \
+    idx  = (uint32_t)(hash_fn(key)) & mask;                                   \
+    while(hash->flags[idx] != CHASH_TPL_FLAG_EMPTY) {                         \
+        if(hash->flags[idx] == CHASH_TPL_FLAG_DELETED) {                      \
+            if(!has_tomb) { tomb = idx; has_tomb = true; }                    \
+        } else if(eq_fn(hash->keys[idx], key)) {                              \
+            if(is_new) *is_new = false;                                       \
+            return &(hash->vals[idx]);                                        \
+        }                                                                     \
+        idx = (idx + 1) & mask;                                               \
+    }                                                                         \
+                                                                              \
+    if(has_tomb) {                                                            \
+        idx = tomb;                                                           \
+    } else {                                                                  \
+        ++hash->cnt_used;                                                     \
+    }                                                                         \
+    hash->flags[idx] = CHASH_TPL_FLAG_USED;                                   \
+    hash->keys[idx]  = key;                                                   \
+    ++hash->cnt_items;                                                        \
+    if(is_new) *is_new = true;                                                \
+                                                                              \
+    return &(hash->vals[idx]);                                                \
+}                                                                             \
+                                                                              \
+static inline bool name##_set(name *hash, key_type key, val_type val)         \
+{                                                                             \
+    val_type *slot = name##_put(hash, key, NULL);                             \
+                                                                              \
+    if(NULL == slot) return false;                                            \
+    *slot = val;                                                              \
+                                                                              \
+    return true;                                                              \
+}                                                                             \
+                                                                              \
+static inline bool name##_haskey(const name *hash, key_type key)              \
+{                                                                             \
+    return name##_find(hash, key) != hash->bkts_num;                          \
+}                                                                             \
+                                                                              \
+/* 返回 value 的指针, 不存在返回 NULL */                                      \
+static inline val_type* name##_get(const name *hash, key_type key)            \
+{                                                                             \
+    uint32_t idx = name##_find(hash, key);                                    \
+                                                                              \
+    return idx != hash->bkts_num ? &(hash->vals[idx]) : NULL;                 \
+}                                                                             \
+                                                                              \
+static inline void name##_del_at(name *hash, uint32_t idx)                    \
+{                                                                             \
+    if(idx < hash->bkts_num && hash->flags[idx] == CHASH_TPL_FLAG_USED) {     \
+        hash->flags[idx] = CHASH_TPL_FLAG_DELETED;                            \
+        --hash->cnt_items;                                                    \
+    }                                                                         \
+}                                                                             \
+                                                                              \
+static inline bool name##_del(name *hash, key_type key)                       \
+{                                                                             \
+    uint32_t idx = name##_find(hash, key);                                    \
+                                                                              \
+    if(idx == hash->bkts_num) return false;                                   \
+    name##_del_at(hash, idx);                                                 \
+                                                                              \
+    return true;                                                              \
+}                                                                             \
+                                                                              \
+/* 迭代: 槽位下标, 到达 name##_end() 结束 */                                  \
+static inline uint32_t name##_end(const name *hash)                           \
+{                                                                             \
+    return hash->bkts_num;                                                    \
+}                                                                             \
+                                                                              \
+static inline uint32_t name##_next(const name *hash, uint32_t idx)            \
+{                                                                             \
+    for(++idx; idx < hash->bkts_num; ++idx) {                                 \
+        if(hash->flags[idx] == CHASH_TPL_FLAG_USED) break;                    \
+    }                                                                         \
+                                                                              \
+    return idx;                                                               \
+}                                                                             \
+                                                                              \
+static inline uint32_t name##_begin(const name *hash)                         \
+{                                                                             \
+    if(0 == hash->bkts_num) return 0;                                         \
+    if(hash->flags[0] == CHASH_TPL_FLAG_USED) return 0;                       \
+                                                                              \
+    return name##_next(hash, 0);                                              \
+}                                                                             \
+                                                                              \
+static inline key_type name##_key(const name *hash, uint32_t idx)             \
+{                                                                             \
+    return hash->keys[idx];                                                   \
+}                                                                             \
+                                                                              \
+static inline val_type* name##_value(const name *hash, uint32_t idx)          \
+{                                                                             \
+    return &(hash->vals[idx]);                                                \
+}
+
+#ifdef __cplusplus
+}
+#endif
+#endif  /* CHASH_TPL_H_202610191010 */
@@ -0,0 +1,66 @@
+#ifndef CHEAP_H_202610192310
+#define CHEAP_H_202610192310
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* {{{
+ * =============================================================================
+ *      Filename    :   cheap.h
+ *      Description :   优先队列 (最小堆)
+ *
+ *          元素保存在 cvector 中, 按 d 叉堆排列 (d 为 2 的幂, 默认 2),
+ *          d 取 4 或 8 时每次下沉访问的子节点在同一个 cache line 附近,
+ *          层数更少. cmp 为 NULL 时使用 cobj_cmp, cmp 最小的元素在堆顶.
+ *
+ *          push 返回 handle, 在元素被 pop / remove 之前一直有效, 用于
+ *          decrease_key / update / remove, 元素出堆后 handle 会被复用.
+ *      Created     :   2026-10-19 23:10:05
+ *      Author      :   Wu Hong
+ * =============================================================================
+ }}} */
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include "cobj.h"
+#include "cvector.h"
+
+typedef struct cheap cheap;
+
+typedef size_t cheap_handle;
+#define CHEAP_HANDLE_NONE ((cheap_handle)-1)
+
+cheap* cheap_new(cobj_cb_cmp cmp);
+cheap* cheap_new_dary(cobj_cb_cmp cmp, unsigned int d);    /* d 不是 2 的幂或大于 16 时返回 NULL */
+/*
+ * 把 v 的全部元素移到新的堆中 (v 被清空), O(n) 建堆,
+ * 原来 v 中下标为 i 的元素的 handle 为 i. 失败时返回 NULL, v 保持不变.
+ */
+cheap* cheap_new_from_vector(cvector *v, cobj_cb_cmp cmp, unsigned int d);
+void cheap_free(cheap *heap);       /* 剩余的元素使用 cobj_free 释放 */
+void cheap_clear(cheap *heap);
+void cheap_print(const cheap *heap);
+
+bool   cheap_is_empty(const cheap *heap);
+size_t cheap_size(const cheap *heap);
+
+/* 失败时返回 CHEAP_HANDLE_NONE, obj 仍由调用者负责释放 */
+cheap_handle cheap_push(cheap *heap, void *obj);
+void* cheap_peek(const cheap *heap);
+void* cheap_pop_min(cheap *heap);
+
+/* handle 无效时返回 NULL / false */
+void* cheap_handle_obj(const cheap *heap, cheap_handle handle);
+/*
+ * 用更小的 obj 替换 handle 的元素, 旧元素使用 cobj_free 释放 (obj 就是
+ * 原来的元素时不释放). obj 比原来的元素大时返回 false, 堆保持不变.
+ */
+bool  cheap_decrease_key(cheap *heap, cheap_handle handle, void *obj);
+/* handle 的元素被直接修改后调整它的位置, 变大变小都可以 */
+bool  cheap_update(cheap *heap, cheap_handle handle);
+void* cheap_remove(cheap *heap, cheap_handle handle);
+
+#ifdef __cplusplus
+}
+#endif
+#endif  /* CHEAP_H_202610192310 */
@@ -0,0 +1,84 @@
+#ifndef CILIST_H_202610191430
+#define CILIST_H_202610191430
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* {{{
+ * =============================================================================
+ *      Filename    :   cilist.h
+ *      Description :   侵入式双向链表
+ *
+ *          clist_link 嵌入到用户的结构体中, 插入和删除都不需要分配内存,
+ *          通过 cilist_entry 由 clist_link 得到所在的结构体.
+ *          cilist 不拥有其中的元素, cilist_free 不会释放元素.
+ *      Created     :   2026-10-19 14:30:12
+ *      Author      :   Wu Hong
+ * =============================================================================
+ }}} */
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+typedef struct clist_link {
+    struct clist_link *prev;
+    struct clist_link *next;
+}clist_link;
+
+typedef struct cilist {
+    unsigned int len;
+
+    clist_link *head;
+    clist_link *tail;
+}cilist;
+
+#ifndef container_of
+#define container_of(ptr, type, member) \
+    ((type*)((char*)(ptr) - offsetof(type, member)))
+#endif
+
+#define cilist_entry(link, type, member) container_of(link, type, member)
+
+#define cilist_foreach(list, link)                          \
+    for(link = (list)->head; link; link = link->next)
+#define cilist_foreach_tail(list, link)                     \
+    for(link = (list)->tail; link; link = link->prev)
+
+/* 遍历过程中可以删除当前的 link */
+#define cilist_foreach_safe(list, link, link_next)          \
+    for(link = (list)->head;                                \
+        link && (link_next = link->next, 1);                \
+        link = link_next)
+
+#define cilist_foreach_entry(list, link, entry, type, member)                 \
+    for(link = (list)->head;                                                  \
+        (entry = NULL, link) && (entry = cilist_entry(link, type, member), 1);\
+        link = link->next)
+#define cilist_foreach_entry_tail(list, link, entry, type, member)            \
+    for(link = (list)->tail;                                                  \
+        (entry = NULL, link) && (entry = cilist_entry(link, type, member), 1);\
+        link = link->prev)
+
+void cilist_init(cilist *list);
+cilist* cilist_new(void);
+void cilist_free(cilist *list);
+void cilist_clear(cilist *list);
+
+bool cilist_is_empty(const cilist *list);
+unsigned int cilist_len(const cilist *list);
+
+void cilist_append(cilist *list, clist_link *link);
+void cilist_prepend(cilist *list, clist_link *link);
+void cilist_insert_before(cilist *list, clist_link *pos, clist_link *link);
+void cilist_insert_after(cilist *list, clist_link *pos, clist_link *link);
+void cilist_remove(cilist *list, clist_link *link);     /* O(1) */
+clist_link* cilist_pop_front(cilist *list);
+clist_link* cilist_pop_back(cilist *list);
+clist_link* cilist_first(const cilist *list);
+clist_link* cilist_last(const cilist *list);
+
+#ifdef __cplusplus
+}
+#endif
+#endif  /* CILIST_H_202610191430 */
@@ -0,0 +1,45 @@
+#ifndef CLFQUEUE_H_202610191650
+#define CLFQUEUE_H_202610191650
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* {{{
+ * =============================================================================
+ *      Filename    :   clfqueue.h
+ *      Description :   无锁多生产者多消费者有界队列
+ *
+ *          基于环形数组, 每个槽位带有序号 (参考 Dmitry Vyukov 的 bounded
+ *          MPMC queue), append / pop_front 只需要一次 CAS, 不会阻塞.
+ *          接口与 clist 的 append / pop_front 一致, 队列满时 append 返回
+ *          false, 队列空时 pop_front 返回 NULL.
+ *      Created     :   2026-10-19 16:50:33
+ *      Author      :   Wu Hong
+ * =============================================================================
+ }}} */
+
+#include <stdlib.h>
+#include <stdbool.h>
+
+typedef struct clfqueue clfqueue;
+
+clfqueue* clfqueue_new(unsigned int capacity);  /* 向上取整为 2 的幂 */
+void clfqueue_free(clfqueue *queue);            /* 剩余的元素使用 cobj_free 释放 */
+
+unsigned int clfqueue_capacity(const clfqueue *queue);
+unsigned int clfqueue_size(const clfqueue *queue);  /* 并发时为近似值 */
+bool clfqueue_is_empty(const clfqueue *queue);
+
+bool  clfqueue_append(clfqueue *queue, void *obj);
+void* clfqueue_pop_front(clfqueue *queue);
+
+/*
+ * 批量操作只做一次 CAS, 返回实际入队 / 出队的个数
+ */
+unsigned int clfqueue_append_batch(clfqueue *queue, void **objs, unsigned int n);
+unsigned int clfqueue_pop_front_batch(clfqueue *queue, void **objs, unsigned int max_n);
+
+#ifdef __cplusplus
+}
+#endif
+#endif  /* CLFQUEUE_H_202610191650 */
@@ -13,14 +13,20 @@ extern "C" {
  * =============================================================================
  }}} */
 
+/* 加锁接口始终可用, 是否加锁由每个 list 的 clist_lock_type 决定 */
 #define CLIST_ENABLE_SEM
 
 #include <stdlib.h>
 #include <stdbool.h>
+#include <sys/types.h>
 #include "cobj.h"
-#ifdef CLIST_ENABLE_SEM
 #include "csem.h"
-#endif
+
+typedef enum clist_lock_type {
+    CLIST_LOCK_NONE = 0,    /* clist_lock 等为空操作 */
+    CLIST_LOCK_MUTEX,       /* 第一次加锁时才创建 csem */
+    CLIST_LOCK_SPIN,        /* 自旋锁, 不占用额外内存 */
+} clist_lock_type;
 
 typedef struct clist_node {
     void *val;
@@ -29,14 +35,29 @@ typedef struct clist_node {
     struct clist_node *next;
 }clist_node;
 
+/*
+ * 节点内存池: 按 slab 批量分配 clist_node, 释放的节点放入空闲链表复用.
+ * 可以由多个 clist 共享 (例如每个线程一个), 但本身不加锁.
+ */
+typedef struct clist_pool clist_pool;
+
 typedef struct clist {
-#ifdef CLIST_ENABLE_SEM
-    csem   *sem;
-#endif
-    unsigned int len;
+    union {
+        csem *sem;          /* CLIST_LOCK_MUTEX */
+        int  spin;          /* CLIST_LOCK_SPIN */
+    } lock;
+    size_t       len;
+    unsigned char lock_type;
+    bool         own_pool;  /* pool 由 list 创建, 随 list 一起释放 */
 
     clist_node *head;
     clist_node *tail;
+
+    clist_pool *pool;       /* NULL 时节点直接使用 malloc/free */
+
+    /* 最近一次按下标访问的节点, 用于加速相邻下标的访问, NULL 表示无效 */
+    clist_node   *finger;
+    size_t       finger_idx;
 }clist;
 
 typedef enum clist_iter_dir {
@@ -79,10 +100,19 @@ void  clist_iter_to_next(clist_iter *iter);
 void  clist_iter_to_prev(clist_iter *iter);
 bool  clist_iter_is_end(clist_iter *iter);
 
+/* ==========================================================================
+ *        clist pool interface
+ * ========================================================================== */
+clist_pool* clist_pool_new(unsigned int nodes_per_slab);
+void clist_pool_free(clist_pool *pool);
+
 /* ==========================================================================
  *        clist interface
  * ========================================================================== */
-clist* clist_new(void);
+clist* clist_new(void);                         /* CLIST_LOCK_MUTEX */
+clist* clist_new_with_lock(clist_lock_type lock_type);
+clist* clist_new_with_pool(clist_pool *pool);   /* 使用共享的 pool */
+clist* clist_new_pooled(void);                  /* 使用 list 私有的 pool */
 void clist_print(const clist* list);
 
 bool clist_is_empty(const clist *list);
@@ -90,14 +120,16 @@ unsigned int clist_size(const clist *list);
 unsigned int clist_count(const clist *list);
 unsigned int clist_len(const clist *list);
 
-#ifdef CLIST_ENABLE_SEM
+/* 只能在没有其他线程使用该 list 时修改 */
+void clist_set_lock_type(clist *list, clist_lock_type lock_type);
+clist_lock_type clist_get_lock_type(const clist *list);
 void clist_lock(clist *list);
 int  clist_lock_timed(clist *list, int ms);
 void clist_unlock(clist *list);
-#endif
 
 void clist_append(clist *list, void *obj);
 void clist_prepend(clist *list, void *obj);
+void clist_insert_at(clist *list, int index, void *obj);
 void* clist_pop_back(clist *list);
 void* clist_pop_front(clist *list);
 void* clist_pop(const clist_iter *iter);
@@ -121,8 +153,24 @@ void* clist_last_obj(clist *list);
 
 void clist_move(clist *list, int from, int to);
 void clist_swap(clist *list, int i, int j);
+/* 稳定的归并排序, 只修改节点指针, 不分配内存. 已有序 (或严格逆序) 的段直接使用 */
 void clist_sort_asc(clist *list);   /* sort list by order asc */
 void clist_sort_desc(clist *list);
+void clist_sort_with_cb(clist *list, cobj_cb_cmp cmp);  /* 按 cmp 升序 */
+/* 把有序的 src 合并到有序的 dst (cmp 为 NULL 时使用 cobj_cmp), src 被清空 */
+void clist_merge(clist *dst, clist *src, cobj_cb_cmp cmp);
+
+/*
+ * 两个 list 使用相同的节点分配方式 (都没有 pool 或共享同一个 pool) 时只修改
+ * 指针, 否则在 dst 中重新分配节点. 迭代器须为正向迭代器.
+ * clist_splice 把 src 的 [first, last) 移到 dst 的 pos 之前, last / pos 为
+ * NULL 或 end 表示末尾. pos 不在 [first, last) 中时 dst 可以是 src.
+ */
+void clist_splice(clist *dst, const clist_iter *pos, clist *src,
+                  const clist_iter *first, const clist_iter *last);
+void clist_concat(clist *dst, clist *src);      /* src 被清空 */
+/* 把 [iter, end) 移到新的 list 并返回, 失败时返回 NULL */
+clist* clist_split_at(clist *list, const clist_iter *iter);
 
 void clist_remove(clist_iter *iter);
 void clist_remove_at(clist *list, int index);
@@ -131,6 +179,18 @@ void clist_remove_last(clist *list);
 void clist_free(clist *list);
 void clist_clear(clist *list);
 
+/*
+ * 64 位接口: 长度超过 UINT_MAX 时 clist_len 等返回 UINT_MAX, int 下标
+ * 只能访问前 INT_MAX 个节点. 下标的含义与 int 接口相同.
+ */
+size_t clist_len64(const clist *list);
+void  clist_insert_at64(clist *list, ssize_t index, void *obj);
+clist_iter clist_at64(clist *list, ssize_t index);
+void* clist_at_obj64(clist *list, ssize_t index);
+void  clist_move64(clist *list, ssize_t from, ssize_t to);
+void  clist_swap64(clist *list, ssize_t i, ssize_t j);
+void  clist_remove_at64(clist *list, ssize_t index);
+
 #ifdef __cplusplus
 }
 #endif
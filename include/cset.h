@@ -0,0 +1,58 @@
+#ifndef CSET_H_202610191830
+#define CSET_H_202610191830
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* {{{
+ * =============================================================================
+ *      Filename    :   cset.h
+ *      Description :   保持插入顺序的集合
+ *
+ *          元素按 clist 的顺序保存, 另外用 hash 表 (cobj_hash / cobj_equal)
+ *          记录元素到 clist_node 的索引, find / remove 为 O(1), 遍历顺序
+ *          与插入顺序一致. 遍历使用 clist_iter, 但不能通过 iter 修改集合.
+ *      Created     :   2026-10-19 18:30:44
+ *      Author      :   Wu Hong
+ * =============================================================================
+ }}} */
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include "clist.h"
+
+typedef struct cset cset;
+
+cset* cset_new(void);
+void cset_free(cset *set);      /* 元素使用 cobj_free 释放 */
+void cset_clear(cset *set);
+void cset_print(const cset *set);
+
+bool cset_is_empty(const cset *set);
+unsigned int cset_len(const cset *set);
+
+/*
+ * 元素已存在时返回 false, obj 仍由调用者负责释放
+ */
+bool cset_append(cset *set, void *obj);
+bool cset_prepend(cset *set, void *obj);
+
+bool  cset_contains(const cset *set, const void *obj);
+clist_iter cset_find(cset *set, const void *obj);   /* 不存在时为 end */
+void* cset_find_obj(const cset *set, const void *obj);
+
+bool  cset_remove(cset *set, const void *obj);  /* 释放集合中的元素 */
+void* cset_take(cset *set, const void *obj);    /* 移出元素但不释放 */
+void* cset_pop_front(cset *set);
+void* cset_pop_back(cset *set);
+
+clist_iter cset_begin(cset *set);
+clist_iter cset_rbegin(cset *set);
+clist_iter cset_end(cset *set);
+void* cset_begin_obj(cset *set);
+void* cset_last_obj(cset *set);
+
+#ifdef __cplusplus
+}
+#endif
+#endif  /* CSET_H_202610191830 */
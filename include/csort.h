@@ -0,0 +1,71 @@
+#ifndef CSORT_H_202610192050
+#define CSORT_H_202610192050
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* {{{
+ * =============================================================================
+ *      Filename    :   csort.h
+ *      Description :   void* 数组的排序和二分查找
+ *
+ *          cmp 为 NULL 时使用 cobj_cmp, 均为升序.
+ *          csort_sort 为 pattern-defeating quicksort (pdqsort): 小区间用插入
+ *          排序, 已有序的区间线性时间完成, 划分不均匀时打乱模式, 最坏情况
+ *          退化为堆排序, 保证 O(n log n).
+ *      Created     :   2026-10-19 20:50:05
+ *      Author      :   Wu Hong
+ * =============================================================================
+ }}} */
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "cobj.h"
+
+void csort_sort(void **objs, size_t n, cobj_cb_cmp cmp);
+/* 归并排序, 需要 n 个指针的临时空间, 分配失败时退化为插入排序 */
+void csort_stable_sort(void **objs, size_t n, cobj_cb_cmp cmp);
+/*
+ * 分成 nthreads 段分别排序, 再两两归并 (不稳定).
+ * 需要 n 个指针的临时空间, 分配失败时在当前线程排序.
+ */
+void csort_sort_parallel(void **objs, size_t n, cobj_cb_cmp cmp, int nthreads);
+
+/*
+ * objs 必须已按 cmp 升序排列.
+ * lower_bound 返回第一个 >= key 的位置, upper_bound 返回第一个 > key 的位置,
+ * 不存在时返回 n
+ */
+size_t csort_lower_bound(void *const *objs, size_t n, const void *key, cobj_cb_cmp cmp);
+size_t csort_upper_bound(void *const *objs, size_t n, const void *key, cobj_cb_cmp cmp);
+
+/* ==========================================================================
+ *        radix sort
+ *
+ *  不调用比较函数, 适合整数 key 和较短的字符串. 临时空间保存在
+ *  csort_radix 中, 多次排序时可以复用, 传 NULL 时每次临时分配.
+ *  内存分配失败时返回 false, 数组保持不变.
+ * ========================================================================== */
+typedef struct csort_radix csort_radix;
+
+/* 返回保持顺序的无符号 key, 有符号数需要翻转符号位 */
+typedef uint64_t    (*csort_cb_key)(const void *obj);
+typedef const char* (*csort_cb_str)(const void *obj);
+
+uint64_t    csort_key_cobj_int(const void *obj);    /* cobj_int */
+const char* csort_str_cobj_str(const void *obj);    /* cobj_str */
+
+csort_radix* csort_radix_new(void);
+void csort_radix_free(csort_radix *ctx);
+
+/* LSD radix sort, 稳定, 所有 key 都相同的字节会被跳过 */
+bool csort_radix_sort(csort_radix *ctx, void **objs, size_t n, csort_cb_key key);
+bool csort_radix_sort_u64(csort_radix *ctx, uint64_t *keys, size_t n);
+/* MSD radix sort (American flag sort), 原地交换, 不稳定 */
+bool csort_radix_sort_str(csort_radix *ctx, void **objs, size_t n, csort_cb_str str);
+
+#ifdef __cplusplus
+}
+#endif
+#endif  /* CSORT_H_202610192050 */
@@ -0,0 +1,112 @@
+#ifndef CULIST_H_202610191520
+#define CULIST_H_202610191520
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* {{{
+ * =============================================================================
+ *      Filename    :   culist.h
+ *      Description :   展开链表 (unrolled linked list)
+ *
+ *          每个节点占 CULIST_NODE_SIZE 字节, 其中保存若干个元素指针,
+ *          顺序遍历时每次 cache miss 可以得到多个元素.
+ *          接口与 clist 一致: append / prepend / pop / 迭代器.
+ *      Created     :   2026-10-19 15:20:47
+ *      Author      :   Wu Hong
+ * =============================================================================
+ }}} */
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include "cobj.h"
+
+#define CULIST_NODE_SIZE    128
+#define CULIST_NODE_CAP     \
+    ((CULIST_NODE_SIZE - 2 * sizeof(void*) - 2 * sizeof(unsigned short)) / sizeof(void*))
+
+typedef struct culist_node {
+    struct culist_node *prev;
+    struct culist_node *next;
+
+    unsigned short first;   /* 第一个元素在 vals 中的下标 */
+    unsigned short count;
+    void *vals[CULIST_NODE_CAP];
+}culist_node;
+
+typedef struct culist {
+    unsigned int len;
+
+    culist_node *head;
+    culist_node *tail;
+    culist_node *spare;     /* 缓存一个空节点, 队列式使用时避免反复 malloc */
+}culist;
+
+typedef enum culist_iter_dir {
+    CULIST_ITER_DIR_FORWORD = 0,
+    CULIST_ITER_DIR_BACKWORD
+} culist_iter_dir;
+
+typedef struct culist_iter {
+    culist_iter_dir dir;
+    culist          *list;
+    culist_node     *node;
+    unsigned short  idx;    /* 元素在 node->vals 中的下标 */
+}culist_iter;
+
+/*
+ * 按节点顺序遍历, idx 为 unsigned int. 由两层循环组成, break 只能跳出内层
+ */
+#define culist_foreach_val(list, node, idx, val_ptr)                          \
+    for(node = (list)->head; node; node = node->next)                         \
+        for(idx = node->first;                                                \
+            idx < (unsigned int)(node->first + node->count)                   \
+            && (val_ptr = node->vals[idx], 1);                                \
+            ++idx)
+
+#define culist_iter_foreach(iter_ptr) \
+    for(; !culist_iter_is_end(iter_ptr); culist_iter_to_next(iter_ptr))
+#define culist_iter_foreach_obj(iter_ptr, obj_ptr)          \
+    for(;    !culist_iter_is_end(iter_ptr) \
+          && (obj_ptr = culist_iter_obj(iter_ptr), 1); \
+        culist_iter_to_next(iter_ptr))
+
+/*
+ * culist iterator interface
+ */
+void* culist_iter_obj(culist_iter *iter);
+void  culist_iter_to_next(culist_iter *iter);
+void  culist_iter_to_prev(culist_iter *iter);
+bool  culist_iter_is_end(culist_iter *iter);
+
+/* ==========================================================================
+ *        culist interface
+ * ========================================================================== */
+culist* culist_new(void);
+void culist_free(culist *list);
+void culist_clear(culist *list);
+void culist_print(const culist* list);
+
+bool culist_is_empty(const culist *list);
+unsigned int culist_size(const culist *list);
+unsigned int culist_len(const culist *list);
+
+void culist_append(culist *list, void *obj);
+void culist_prepend(culist *list, void *obj);
+void* culist_pop_back(culist *list);
+void* culist_pop_front(culist *list);
+void* culist_pop(culist_iter *iter);
+
+culist_iter culist_at(culist *list, int index);
+culist_iter culist_begin(culist *list);
+culist_iter culist_rbegin(culist *list);
+void* culist_at_obj(culist *list, int index);
+void* culist_begin_obj(culist *list);
+void* culist_last_obj(culist *list);
+
+void culist_remove(culist_iter *iter);
+
+#ifdef __cplusplus
+}
+#endif
+#endif  /* CULIST_H_202610191520 */
@@ -13,22 +13,42 @@ extern "C" {
  * =============================================================================
  }}} */
 
+#include <sys/types.h>
 #include "cobj.h"
 
+/*
+ * 容量不足时的增长策略
+ */
+typedef enum cvector_growth {
+    CVECTOR_GROWTH_DOUBLE = 0,  /* 翻倍, 默认 */
+    CVECTOR_GROWTH_HALF,        /* 增长 1.5 倍, 浪费的内存更少 */
+    CVECTOR_GROWTH_EXACT,       /* 只增长到需要的大小, 适合已 reserve 的 vector */
+} cvector_growth;
+
+/*
+ * 前 CVECTOR_INLINE_SIZE 个元素直接存放在结构体中, 超过时才分配堆内存,
+ * 所以 cvector_init 不分配内存, cvector_new 只分配结构体本身.
+ * 使用内嵌数组时 objs 指向结构体内部, 不能按值复制 cvector.
+ */
+#define CVECTOR_INLINE_SIZE 4
+
 typedef struct cvector
 {
-    unsigned int size_alloc;
-    unsigned int size_offset;
+    size_t size_alloc;
+    size_t size_offset;
     void **objs;
+    unsigned char growth;       /* cvector_growth */
+    bool          mapped;       /* 大的 vector 使用 mmap 分配, 用 mremap 增长 */
+    void *inline_objs[CVECTOR_INLINE_SIZE];
 }cvector;
 
 typedef struct cvector_iter
 {
     cvector *v;
-    int i;
+    ssize_t i;
 }cvector_iter;
 
-void cvector_iter_init(cvector_iter *iter, cvector *v, int i);
+void cvector_iter_init(cvector_iter *iter, cvector *v, ssize_t i);
 bool cvector_iter_is_end(const cvector_iter *iter);
 void* cvector_iter_pobj(cvector_iter *iter);
 cvector_iter cvector_iter_next(const cvector_iter *iter);
@@ -37,8 +57,10 @@ cvector_iter cvector_iter_prev(const cvector_iter *iter);
 void cvector_iter_to_prev(cvector_iter *iter);
 
 void cvector_init(cvector *v);
+void cvector_init_with_capacity(cvector *v, size_t capacity);
 void cvector_release(cvector *v);
 cvector* cvector_new(void);
+cvector* cvector_new_with_capacity(size_t capacity);
 void cvector_free(cvector *v);
 void cvector_clear(cvector *v);
 bool cvector_is_empty(const cvector *v);
@@ -46,10 +68,23 @@ int  cvector_length(const cvector *v);
 int  cvector_size(const cvector *v);
 void cvector_print(const cvector *v);
 
+size_t cvector_capacity(const cvector *v);
+bool cvector_reserve(cvector *v, size_t capacity);  /* 不会缩小, 超过上限时返回 false */
+void cvector_shrink_to_fit(cvector *v);
+void cvector_set_growth(cvector *v, cvector_growth growth);
+
 void cvector_insert(cvector *v, int i, void *obj);
 void cvector_insert_with_iter(cvector *v, cvector_iter *iter, void *obj);
+void cvector_insert_range(cvector *v, int i, void **objs, int n);
 void cvector_append(cvector *v, void *obj);
+void cvector_append_array(cvector *v, void **objs, int n);
 void cvector_prepend(cvector *v, void *obj);
+/*
+ * 把 other 的全部元素 / src 的 [first, last) 移到 v / dst 中,
+ * 元素的所有权一起转移, 被移走的元素从 other / src 中删除
+ */
+void cvector_extend(cvector *v, cvector *other);
+void cvector_splice(cvector *dst, int i, cvector *src, int first, int last);
 void* cvector_pop(cvector *v, cvector_iter *iter);
 void* cvector_pop_at(cvector *v, int i);
 void* cvector_pop_front(cvector *v);
@@ -72,6 +107,37 @@ void cvector_remove_at(cvector *v, int i);
 void cvector_remove_at_range(cvector *v, int first, int last);
 void cvector_replace(cvector *v, int i, void *obj);
 
+/*
+ * 排序和二分查找, cmp 为 NULL 时使用 cobj_cmp, 见 csort.h
+ */
+void cvector_sort(cvector *v, cobj_cb_cmp cmp);
+void cvector_stable_sort(cvector *v, cobj_cb_cmp cmp);
+void cvector_sort_parallel(cvector *v, cobj_cb_cmp cmp, int nthreads);
+/* v 必须已排序, 返回相等元素的下标, 不存在时返回 -1 */
+int  cvector_bsearch(const cvector *v, const void *obj, cobj_cb_cmp cmp);
+int  cvector_lower_bound(const cvector *v, const void *obj, cobj_cb_cmp cmp);
+int  cvector_upper_bound(const cvector *v, const void *obj, cobj_cb_cmp cmp);
+
+/*
+ * 64 位接口: 上面的 int 接口只能访问前 INT_MAX 个元素, 长度和下标超过
+ * INT_MAX 时返回 INT_MAX. 元素个数上限为 PTRDIFF_MAX / sizeof(void*),
+ * 增长时检查溢出, 失败时打印错误, vector 保持不变. 下标的含义与 int 接口相同.
+ */
+size_t cvector_size64(const cvector *v);
+void  cvector_insert64(cvector *v, ssize_t i, void *obj);
+void  cvector_insert_range64(cvector *v, ssize_t i, void **objs, size_t n);
+void  cvector_append_array64(cvector *v, void **objs, size_t n);
+void  cvector_splice64(cvector *dst, ssize_t i, cvector *src,
+                       ssize_t first, ssize_t last);
+void* cvector_pop_at64(cvector *v, ssize_t i);
+void* cvector_at64(cvector *v, ssize_t i);
+void  cvector_remove_at64(cvector *v, ssize_t i);
+void  cvector_remove_at_range64(cvector *v, ssize_t first, ssize_t last);
+void  cvector_replace64(cvector *v, ssize_t i, void *obj);
+ssize_t cvector_bsearch64(const cvector *v, const void *obj, cobj_cb_cmp cmp);
+size_t  cvector_lower_bound64(const cvector *v, const void *obj, cobj_cb_cmp cmp);
+size_t  cvector_upper_bound64(const cvector *v, const void *obj, cobj_cb_cmp cmp);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,390 @@
+/* {{{
+ * =============================================================================
+ *      Filename    :   carray.c
+ *      Description :
+ *      Created     :   2026-10-19 20:12:55
+ *      Author      :   Wu Hong
+ * =============================================================================
+ }}} */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <sys/types.h>
+#include "carray.h"
+
+#define CARRAY_SIZE_INIT    16
+
+#define CARRAY_CHECK_IDX_FULL(a, i, ret) \
+    do {    \
+        if((i) < 0 || (i) >= (int)((a)->size_offset)){ \
+            printf("[CARRAY]index(%d) out of range(%u)\n", i, (a)->size_offset);\
+            return ret; \
+        }   \
+    }while(0)
+
+#define CARRAY_CHECK_IDX(a, i) CARRAY_CHECK_IDX_FULL(a, i, )
+#define CARRAY_CHECK_IDX_RETURN_NULL(a, i) CARRAY_CHECK_IDX_FULL(a, i, NULL)
+
+#define CARRAY_BYTES(a, n) ((size_t)(n) * (a)->elem_size)
+
+/*********************************************************************
+ *                          Array Iterator                           *
+ *********************************************************************/
+void carray_iter_init(carray_iter *iter, carray *a, int i)
+{
+    iter->a = a;
+    iter->i = i;
+}
+
+bool carray_iter_is_end(const carray_iter *iter)
+{
+    return iter->i >= carray_size(iter->a);
+}
+
+bool carray_iter_is_rend(const carray_iter *iter)
+{
+    return iter->i < 0;
+}
+
+void* carray_iter_pobj(carray_iter *iter)
+{
+    if(iter->i >= 0 && iter->i < carray_size(iter->a)) {
+        return CARRAY_ELEM(iter->a, iter->i);
+    } else {
+        return NULL;
+    }
+}
+
+carray_iter carray_iter_next(const carray_iter *iter)
+{
+    carray_iter iter_next;
+
+    iter_next.a = iter->a;
+    iter_next.i = iter->i + 1;
+
+    return iter_next;
+}
+
+void carray_iter_to_next(carray_iter *iter)
+{
+    ++(iter->i);
+}
+
+carray_iter carray_iter_prev(const carray_iter *iter)
+{
+    carray_iter iter_prev;
+
+    iter_prev.a = iter->a;
+    iter_prev.i = iter->i - 1;
+
+    return iter_prev;
+}
+
+void carray_iter_to_prev(carray_iter *iter)
+{
+    --(iter->i);
+}
+
+static bool carray_realloc(carray *a, unsigned int size_alloc)
+{
+    char *data = NULL;
+
+    if(0 == size_alloc) {
+        free(a->data);
+    } else {
+        data = (char*)realloc(a->data, CARRAY_BYTES(a, size_alloc));
+        if(NULL == data) {
+            printf("[CARRAY]alloc(%u) failed\n", size_alloc);
+            return false;
+        }
+    }
+
+    a->data = data;
+    a->size_alloc = size_alloc;
+
+    return true;
+}
+
+/*
+ * 保证还能放入 n 个元素
+ */
+static bool carray_ensure(carray *a, unsigned int n)
+{
+    size_t need = (size_t)a->size_offset + n;
+    size_t size = a->size_alloc * 2;
+
+    if(need <= a->size_alloc) return true;
+    if(need > UINT_MAX) {
+        printf("[CARRAY]size(%u + %u) overflow\n", a->size_offset, n);
+        return false;
+    }
+
+    if(size < CARRAY_SIZE_INIT) size = CARRAY_SIZE_INIT;
+    if(size < need) size = need;
+    if(size > UINT_MAX) size = UINT_MAX;
+
+    return carray_realloc(a, (unsigned int)size);
+}
+
+void carray_init(carray *a, unsigned int elem_size)
+{
+    a->elem_size   = elem_size;
+    a->size_alloc  = 0;
+    a->size_offset = 0;
+    a->data = NULL;
+}
+
+void carray_release(carray *a)
+{
+    free(a->data);
+    carray_init(a, a->elem_size);
+}
+
+carray* carray_new(unsigned int elem_size)
+{
+    carray *a = (carray*)malloc(sizeof(carray));
+
+    if(a) {
+        carray_init(a, elem_size);
+    }
+
+    return a;
+}
+
+void carray_free(carray *a)
+{
+    if(a) {
+        carray_release(a);
+        free(a);
+    }
+}
+
+void carray_clear(carray *a)
+{
+    a->size_offset = 0;
+}
+
+bool carray_is_empty(const carray *a)
+{
+    return a->size_offset == 0;
+}
+
+int  carray_length(const carray *a)
+{
+    return a->size_offset;
+}
+
+int  carray_size(const carray *a)
+{
+    return a->size_offset;
+}
+
+unsigned int carray_capacity(const carray *a)
+{
+    return a->size_alloc;
+}
+
+bool carray_reserve(carray *a, unsigned int capacity)
+{
+    if(capacity <= a->size_alloc) return true;
+
+    return carray_realloc(a, capacity);
+}
+
+void carray_shrink_to_fit(carray *a)
+{
+    if(a->size_offset < a->size_alloc) {
+        carray_realloc(a, a->size_offset);
+    }
+}
+
+/*
+ * elems 指向 a 自身的数据时返回其字节偏移, 否则返回 -1.
+ * 扩容会使这样的指针失效, 需要在扩容后用偏移重新计算
+ */
+static ssize_t carray_elems_offset(const carray *a, const void *elems)
+{
+    const char *p = (const char*)elems;
+
+    if(NULL == a->data || p < a->data || p >= a->data + CARRAY_BYTES(a, a->size_alloc)) {
+        return -1;
+    }
+
+    return p - a->data;
+}
+
+void carray_insert_range(carray *a, int i, const void *elems, int n)
+{
+    ssize_t off   = carray_elems_offset(a, elems);
+    size_t  pos   = 0;
+    size_t  bytes = 0;
+    size_t  head  = 0;
+
+    if(n <= 0) return;
+
+    if(i < 0) { i += carray_length(a); }
+
+    if(i < 0) { i = 0; }
+    else if(i > carray_length(a)) { i = carray_length(a); }
+
+    if(!carray_ensure(a, n)) return;
+
+    pos   = CARRAY_BYTES(a, i);
+    bytes = CARRAY_BYTES(a, n);
+    memmove(CARRAY_ELEM(a, i + n), CARRAY_ELEM(a, i), CARRAY_BYTES(a, a->size_offset - i));
+
+    if(off < 0) {
+        memcpy(a->data + pos, elems, bytes);
+    } else {
+        /* 位于 i 之后的源数据已随 memmove 后移了 n 个元素 */
+        head = (size_t)off < pos ? pos - (size_t)off : 0;
+        if(head > bytes) head = bytes;
+        memcpy(a->data + pos, a->data + off, head);
+        memcpy(a->data + pos + head, a->data + off + head + bytes, bytes - head);
+    }
+    a->size_offset += n;
+}
+
+void carray_insert(carray *a, int i, const void *elem)
+{
+    carray_insert_range(a, i, elem, 1);
+}
+
+void carray_append_array(carray *a, const void *elems, int n)
+{
+    ssize_t off = carray_elems_offset(a, elems);
+
+    if(n <= 0 || !carray_ensure(a, n)) return;
+
+    if(off >= 0) elems = a->data + off;
+    memcpy(CARRAY_ELEM(a, a->size_offset), elems, CARRAY_BYTES(a, n));
+    a->size_offset += n;
+}
+
+void carray_append(carray *a, const void *elem)
+{
+    carray_append_array(a, elem, 1);
+}
+
+void carray_prepend(carray *a, const void *elem)
+{
+    carray_insert_range(a, 0, elem, 1);
+}
+
+void* carray_emplace_back(carray *a)
+{
+    if(!carray_ensure(a, 1)) return NULL;
+
+    return CARRAY_ELEM(a, a->size_offset++);
+}
+
+bool carray_pop_at(carray *a, int i, void *elem)
+{
+    CARRAY_CHECK_IDX_FULL(a, i, false);
+
+    if(elem) {
+        memcpy(elem, CARRAY_ELEM(a, i), a->elem_size);
+    }
+    memmove(CARRAY_ELEM(a, i), CARRAY_ELEM(a, i + 1), CARRAY_BYTES(a, a->size_offset - i - 1));
+    --(a->size_offset);
+
+    return true;
+}
+
+bool carray_pop_front(carray *a, void *elem)
+{
+    return carray_pop_at(a, 0, elem);
+}
+
+bool carray_pop_back(carray *a, void *elem)
+{
+    if(carray_is_empty(a)) return false;
+
+    --(a->size_offset);
+    if(elem) {
+        memcpy(elem, CARRAY_ELEM(a, a->size_offset), a->elem_size);
+    }
+
+    return true;
+}
+
+void* carray_at(carray *a, int i)
+{
+    CARRAY_CHECK_IDX_RETURN_NULL(a, i);
+
+    return CARRAY_ELEM(a, i);
+}
+
+void* carray_at_first(carray *a)
+{
+    return carray_is_empty(a) ? NULL : CARRAY_ELEM(a, 0);
+}
+
+void* carray_at_last(carray *a)
+{
+    return carray_is_empty(a) ? NULL : CARRAY_ELEM(a, a->size_offset - 1);
+}
+
+void carray_replace(carray *a, int i, const void *elem)
+{
+    CARRAY_CHECK_IDX(a, i);
+
+    memcpy(CARRAY_ELEM(a, i), elem, a->elem_size);
+}
+
+carray_iter carray_begin(carray *a)
+{
+    carray_iter iter;
+
+    carray_iter_init(&iter, a, 0);
+
+    return iter;
+}
+
+carray_iter carray_end(carray *a)
+{
+    carray_iter iter;
+
+    carray_iter_init(&iter, a, carray_size(a));
+
+    return iter;
+}
+
+carray_iter carray_rbegin(carray *a)
+{
+    carray_iter iter;
+
+    carray_iter_init(&iter, a, carray_size(a) - 1);
+
+    return iter;
+}
+
+carray_iter carray_rend(carray *a)
+{
+    carray_iter iter;
+
+    carray_iter_init(&iter, a, -1);
+
+    return iter;
+}
+
+void carray_remove_at_range(carray *a, int first, int last)
+{
+    if(first < 0) first = 0;
+    if(last > carray_size(a)) last = carray_size(a);
+    if(last <= first) return;
+
+    memmove(CARRAY_ELEM(a, first), CARRAY_ELEM(a, last), CARRAY_BYTES(a, a->size_offset - last));
+    a->size_offset -= last - first;
+}
+
+void carray_remove_at(carray *a, int i)
+{
+    carray_remove_at_range(a, i, i + 1);
+}
+
+void carray_remove(carray_iter *iter)
+{
+    carray_remove_at(iter->a, iter->i);
+}
@@ -0,0 +1,173 @@
+/* {{{
+ * =============================================================================
+ *      Filename    :   cbqueue.c
+ *      Description :
+ *      Created     :   2026-10-19 17:46:03
+ *      Author      :   Wu Hong
+ * =============================================================================
+ }}} */
+#include "cbqueue.h"
+#include "cobj.h"
+#include "csem.h"
+
+struct cbqueue
+{
+    void            **objs;
+    unsigned int    capacity;
+    unsigned int    head;
+    unsigned int    len;
+
+    cmutex          *mutex;
+    csem            *items;     /* 可以取走的元素个数 */
+    csem            *slots;     /* 可以放入的空位个数 */
+};
+
+cbqueue* cbqueue_new(unsigned int capacity)
+{
+    cbqueue *queue = NULL;
+
+    if(capacity == 0) return NULL;
+
+    queue = (cbqueue*)calloc(1, sizeof(cbqueue));
+    if(NULL == queue) return NULL;
+
+    queue->objs     = (void**)malloc(sizeof(void*) * capacity);
+    queue->capacity = capacity;
+    queue->mutex    = cmutex_new();
+    queue->items    = csem_new(0);
+    queue->slots    = csem_new(capacity);
+    if(NULL == queue->objs || NULL == queue->mutex ||
+       NULL == queue->items || NULL == queue->slots) {
+        if(queue->mutex) cmutex_free(queue->mutex);
+        if(queue->items) csem_free(queue->items);
+        if(queue->slots) csem_free(queue->slots);
+        free(queue->objs);
+        free(queue);
+        return NULL;
+    }
+
+    return queue;
+}
+
+void cbqueue_free(cbqueue *queue)
+{
+    unsigned int i = 0;
+
+    if(queue) {
+        for(i = 0; i < queue->len; ++i) {
+            cobj_free(queue->objs[(queue->head + i) % queue->capacity]);
+        }
+        cmutex_free(queue->mutex);
+        csem_free(queue->items);
+        csem_free(queue->slots);
+        free(queue->objs);
+        free(queue);
+    }
+}
+
+unsigned int cbqueue_capacity(const cbqueue *queue)
+{
+    return queue->capacity;
+}
+
+unsigned int cbqueue_size(cbqueue *queue)
+{
+    unsigned int len = 0;
+
+    cmutex_lock(queue->mutex);
+    len = queue->len;
+    cmutex_unlock(queue->mutex);
+
+    return len;
+}
+
+/* 调用前已经从 slots 中获取了一个空位 */
+static void cbqueue_put(cbqueue *queue, void *obj)
+{
+    cmutex_lock(queue->mutex);
+    queue->objs[(queue->head + queue->len) % queue->capacity] = obj;
+    ++queue->len;
+    cmutex_unlock(queue->mutex);
+
+    csem_up(queue->items);
+}
+
+/* 调用前已经从 items 中获取了 n 个元素 */
+static void cbqueue_take(cbqueue *queue, void **objs, unsigned int n)
+{
+    unsigned int i = 0;
+
+    cmutex_lock(queue->mutex);
+    for(i = 0; i < n; ++i) {
+        objs[i] = queue->objs[queue->head];
+        queue->head = (queue->head + 1) % queue->capacity;
+    }
+    queue->len -= n;
+    cmutex_unlock(queue->mutex);
+
+    csem_release(queue->slots, n);
+}
+
+void cbqueue_push(cbqueue *queue, void *obj)
+{
+    csem_down(queue->slots);
+    cbqueue_put(queue, obj);
+}
+
+bool cbqueue_try_push(cbqueue *queue, void *obj)
+{
+    if(!csem_try_lock(queue->slots)) return false;
+
+    cbqueue_put(queue, obj);
+
+    return true;
+}
+
+void* cbqueue_pop(cbqueue *queue)
+{
+    void *obj = NULL;
+
+    csem_down(queue->items);
+    cbqueue_take(queue, &obj, 1);
+
+    return obj;
+}
+
+void* cbqueue_try_pop(cbqueue *queue)
+{
+    void *obj = NULL;
+
+    if(csem_try_lock(queue->items)) {
+        cbqueue_take(queue, &obj, 1);
+    }
+
+    return obj;
+}
+
+void* cbqueue_pop_timed(cbqueue *queue, int msec)
+{
+    void *obj = NULL;
+
+    if(0 == csem_down_timed(queue->items, msec)) {
+        cbqueue_take(queue, &obj, 1);
+    }
+
+    return obj;
+}
+
+unsigned int cbqueue_pop_batch(cbqueue *queue, void **objs, unsigned int max_n)
+{
+    unsigned int n = 1;
+
+    if(max_n == 0) return 0;
+
+    /* 只在第一个元素上阻塞, 其余已就绪的元素不需要再次唤醒 */
+    csem_down(queue->items);
+    while(n < max_n && csem_try_lock(queue->items)) {
+        ++n;
+    }
+
+    cbqueue_take(queue, objs, n);
+
+    return n;
+}
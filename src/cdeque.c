@@ -0,0 +1,326 @@
+/* {{{
+ * =============================================================================
+ *      Filename    :   cdeque.c
+ *      Description :
+ *      Created     :   2026-10-19 19:31:40
+ *      Author      :   Wu Hong
+ * =============================================================================
+ }}} */
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include "cdeque.h"
+
+#define CDEQUE_SIZE_INIT    16
+
+#define CDEQUE_OBJ(dq, i)   ((dq)->objs[((dq)->head + (i)) & ((dq)->size_alloc - 1)])
+
+/*********************************************************************
+ *                          Deque Iterator                           *
+ *********************************************************************/
+void cdeque_iter_init(cdeque_iter *iter, cdeque *dq, int i)
+{
+    iter->dq = dq;
+    iter->i  = i;
+}
+
+bool cdeque_iter_is_end(const cdeque_iter *iter)
+{
+    return iter->i >= cdeque_size(iter->dq);
+}
+
+bool cdeque_iter_is_rend(const cdeque_iter *iter)
+{
+    return iter->i < 0;
+}
+
+void* cdeque_iter_pobj(cdeque_iter *iter)
+{
+    if(iter->i >= 0 && iter->i < cdeque_size(iter->dq)) {
+        return CDEQUE_OBJ(iter->dq, iter->i);
+    } else {
+        return NULL;
+    }
+}
+
+cdeque_iter cdeque_iter_next(const cdeque_iter *iter)
+{
+    cdeque_iter iter_next;
+
+    iter_next.dq = iter->dq;
+    iter_next.i  = iter->i + 1;
+
+    return iter_next;
+}
+
+void cdeque_iter_to_next(cdeque_iter *iter)
+{
+    ++(iter->i);
+}
+
+cdeque_iter cdeque_iter_prev(const cdeque_iter *iter)
+{
+    cdeque_iter iter_prev;
+
+    iter_prev.dq = iter->dq;
+    iter_prev.i  = iter->i - 1;
+
+    return iter_prev;
+}
+
+void cdeque_iter_to_prev(cdeque_iter *iter)
+{
+    --(iter->i);
+}
+
+/*
+ * 重新分配为 size_alloc 个槽位 (2 的幂), 元素移动到数组的开头
+ */
+static bool cdeque_realloc(cdeque *dq, unsigned int size_alloc)
+{
+    void **objs = (void**)malloc(sizeof(void*) * size_alloc);
+    unsigned int first = 0;
+
+    if(NULL == objs) {
+        printf("[CDEQUE]alloc(%u) failed\n", size_alloc);
+        return false;
+    }
+
+    if(dq->size_offset) {
+        /* 环形数组可能被分成 [head, size_alloc) 和 [0, ...) 两段 */
+        first = dq->size_alloc - dq->head;
+        if(first > dq->size_offset) first = dq->size_offset;
+        memcpy(objs, dq->objs + dq->head, sizeof(void*) * first);
+        memcpy(objs + first, dq->objs, sizeof(void*) * (dq->size_offset - first));
+    }
+
+    free(dq->objs);
+    dq->objs = objs;
+    dq->size_alloc = size_alloc;
+    dq->head = 0;
+
+    return true;
+}
+
+static bool cdeque_grow(cdeque *dq)
+{
+    if(dq->size_offset < dq->size_alloc) return true;
+    if(dq->size_alloc > UINT_MAX / 2) {
+        printf("[CDEQUE]size(%u) overflow\n", dq->size_alloc);
+        return false;
+    }
+
+    return cdeque_realloc(dq, dq->size_alloc ? dq->size_alloc * 2 : CDEQUE_SIZE_INIT);
+}
+
+void cdeque_init(cdeque *dq)
+{
+    dq->size_alloc  = 0;
+    dq->size_offset = 0;
+    dq->head = 0;
+    dq->objs = NULL;
+}
+
+void cdeque_release(cdeque *dq)
+{
+    cdeque_clear(dq);
+    free(dq->objs);
+    cdeque_init(dq);
+}
+
+cdeque* cdeque_new(void)
+{
+    return cdeque_new_with_capacity(0);
+}
+
+cdeque* cdeque_new_with_capacity(unsigned int capacity)
+{
+    cdeque *dq = (cdeque*)malloc(sizeof(cdeque));
+
+    if(dq) {
+        cdeque_init(dq);
+        cdeque_reserve(dq, capacity);
+    }
+
+    return dq;
+}
+
+void cdeque_free(cdeque *dq)
+{
+    if(dq) {
+        cdeque_release(dq);
+        free(dq);
+    }
+}
+
+void cdeque_clear(cdeque *dq)
+{
+    unsigned int i = 0;
+
+    for(i = 0; i < dq->size_offset; ++i) {
+        cobj_free(CDEQUE_OBJ(dq, i));
+    }
+    dq->size_offset = 0;
+    dq->head = 0;
+}
+
+bool cdeque_is_empty(const cdeque *dq)
+{
+    return dq->size_offset == 0;
+}
+
+int  cdeque_length(const cdeque *dq)
+{
+    return dq->size_offset;
+}
+
+int  cdeque_size(const cdeque *dq)
+{
+    return dq->size_offset;
+}
+
+unsigned int cdeque_capacity(const cdeque *dq)
+{
+    return dq->size_alloc;
+}
+
+bool cdeque_reserve(cdeque *dq, unsigned int capacity)
+{
+    unsigned int size = dq->size_alloc ? dq->size_alloc : CDEQUE_SIZE_INIT;
+
+    if(capacity <= dq->size_alloc) return true;
+
+    while(size < capacity) {
+        if(size > UINT_MAX / 2) return false;
+        size *= 2;
+    }
+
+    return cdeque_realloc(dq, size);
+}
+
+void cdeque_print(const cdeque *dq)
+{
+    unsigned int i = 0;
+
+    printf("[");
+    for(i = 0; i < dq->size_offset; ++i) {
+        cobj_print(CDEQUE_OBJ(dq, i));
+        if(i != dq->size_offset - 1) {
+            printf(", ");
+        }
+    }
+    printf("]");
+}
+
+void cdeque_append(cdeque *dq, void *obj)
+{
+    if(!cdeque_grow(dq)) return;
+
+    CDEQUE_OBJ(dq, dq->size_offset) = obj;
+    ++(dq->size_offset);
+}
+
+void cdeque_prepend(cdeque *dq, void *obj)
+{
+    if(!cdeque_grow(dq)) return;
+
+    dq->head = (dq->head - 1) & (dq->size_alloc - 1);
+    dq->objs[dq->head] = obj;
+    ++(dq->size_offset);
+}
+
+void* cdeque_pop_front(cdeque *dq)
+{
+    void *obj = NULL;
+
+    if(cdeque_is_empty(dq)) return NULL;
+
+    obj = dq->objs[dq->head];
+    dq->head = (dq->head + 1) & (dq->size_alloc - 1);
+    --(dq->size_offset);
+
+    return obj;
+}
+
+void* cdeque_pop_back(cdeque *dq)
+{
+    if(cdeque_is_empty(dq)) return NULL;
+
+    --(dq->size_offset);
+
+    return CDEQUE_OBJ(dq, dq->size_offset);
+}
+
+void* cdeque_at(cdeque *dq, int i)
+{
+    if(i < 0) i += (int)dq->size_offset;
+    if(i < 0 || i >= (int)dq->size_offset) {
+        printf("[CDEQUE]index(%d) out of range(%u)\n", i, dq->size_offset);
+        return NULL;
+    }
+
+    return CDEQUE_OBJ(dq, i);
+}
+
+void* cdeque_at_first(cdeque *dq)
+{
+    return cdeque_is_empty(dq) ? NULL : CDEQUE_OBJ(dq, 0);
+}
+
+void* cdeque_at_last(cdeque *dq)
+{
+    return cdeque_is_empty(dq) ? NULL : CDEQUE_OBJ(dq, dq->size_offset - 1);
+}
+
+void cdeque_replace(cdeque *dq, int i, void *obj)
+{
+    void *obj_old = NULL;
+
+    if(i < 0) i += (int)dq->size_offset;
+    if(i < 0 || i >= (int)dq->size_offset) {
+        printf("[CDEQUE]index(%d) out of range(%u)\n", i, dq->size_offset);
+        return;
+    }
+
+    obj_old = CDEQUE_OBJ(dq, i);
+    CDEQUE_OBJ(dq, i) = obj;
+    if(obj != obj_old) {
+        cobj_free(obj_old);
+    }
+}
+
+cdeque_iter cdeque_begin(cdeque *dq)
+{
+    cdeque_iter iter;
+
+    cdeque_iter_init(&iter, dq, 0);
+
+    return iter;
+}
+
+cdeque_iter cdeque_end(cdeque *dq)
+{
+    cdeque_iter iter;
+
+    cdeque_iter_init(&iter, dq, cdeque_size(dq));
+
+    return iter;
+}
+
+cdeque_iter cdeque_rbegin(cdeque *dq)
+{
+    cdeque_iter iter;
+
+    cdeque_iter_init(&iter, dq, cdeque_size(dq) - 1);
+
+    return iter;
+}
+
+cdeque_iter cdeque_rend(cdeque *dq)
+{
+    cdeque_iter iter;
+
+    cdeque_iter_init(&iter, dq, -1);
+
+    return iter;
+}
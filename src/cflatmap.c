@@ -0,0 +1,364 @@
+/* {{{
+ * =============================================================================
+ *      Filename    :   cflatmap.c
+ *      Description :
+ *      Created     :   2026-10-20 00:13:02
+ *      Author      :   Wu Hong
+ * =============================================================================
+ }}} */
+#include <string.h>
+#include <stdint.h>
+#include "cflatmap.h"
+
+#define CFLATMAP_RUN    16      /* 归并排序前用插入排序的长度 */
+
+#if defined(__GNUC__)
+#define CFLATMAP_PREFETCH(p) __builtin_prefetch(p)
+#else
+#define CFLATMAP_PREFETCH(p)
+#endif
+
+struct cflatmap
+{
+    cvector     keys;
+    cvector     vals;
+    cobj_cb_cmp cmp;
+};
+
+#define CFLATMAP_KEYS(map) ((map)->keys.objs)
+#define CFLATMAP_VALS(map) ((map)->vals.objs)
+
+cflatmap* cflatmap_new(cobj_cb_cmp cmp)
+{
+    cflatmap *map = (cflatmap*)malloc(sizeof(cflatmap));
+
+    if(NULL == map) return NULL;
+
+    cvector_init(&(map->keys));
+    cvector_init(&(map->vals));
+    map->cmp = cmp ? cmp : cobj_cmp;
+
+    return map;
+}
+
+void cflatmap_free(cflatmap *map)
+{
+    if(map) {
+        cvector_release(&(map->keys));
+        cvector_release(&(map->vals));
+        free(map);
+    }
+}
+
+void cflatmap_clear(cflatmap *map)
+{
+    cvector_clear(&(map->keys));
+    cvector_clear(&(map->vals));
+}
+
+void cflatmap_print(const cflatmap *map)
+{
+    size_t i = 0;
+    size_t n = cflatmap_size(map);
+
+    printf("{");
+    for(i = 0; i < n; ++i) {
+        cobj_print(CFLATMAP_KEYS(map)[i]);
+        printf(": ");
+        cobj_print(CFLATMAP_VALS(map)[i]);
+        if(i != n - 1) {
+            printf(", ");
+        }
+    }
+    printf("}");
+}
+
+bool cflatmap_is_empty(const cflatmap *map)
+{
+    return cvector_is_empty(&(map->keys));
+}
+
+size_t cflatmap_size(const cflatmap *map)
+{
+    return cvector_size64(&(map->keys));
+}
+
+/*
+ * 无分支的二分查找: 每次只缩小区间而不提前退出, 比较结果用于选择
+ * 下一个区间的起点 (编译为 cmov), 避免分支预测失败. 同时预取两个
+ * 可能的下一个中点.
+ */
+size_t cflatmap_lower_bound(const cflatmap *map, const void *key)
+{
+    void   *const *keys = CFLATMAP_KEYS(map);
+    void   *const *base = keys;
+    size_t n    = cflatmap_size(map);
+    size_t half = 0;
+
+    if(0 == n) return 0;
+
+    while(n > 1) {
+        half = n / 2;
+        CFLATMAP_PREFETCH(base + half / 2);
+        CFLATMAP_PREFETCH(base + half + half / 2);
+        base = map->cmp(base[half], key) < 0 ? base + half : base;
+        n -= half;
+    }
+
+    return (size_t)(base - keys) + (map->cmp(*base, key) < 0);
+}
+
+ssize_t cflatmap_find(const cflatmap *map, const void *key)
+{
+    size_t i = cflatmap_lower_bound(map, key);
+
+    if(i < cflatmap_size(map) && 0 == map->cmp(CFLATMAP_KEYS(map)[i], key)) {
+        return (ssize_t)i;
+    }
+
+    return -1;
+}
+
+bool cflatmap_haskey(const cflatmap *map, const void *key)
+{
+    return cflatmap_find(map, key) >= 0;
+}
+
+void* cflatmap_get_value(const cflatmap *map, const void *key)
+{
+    ssize_t i = cflatmap_find(map, key);
+
+    return i < 0 ? NULL : CFLATMAP_VALS(map)[i];
+}
+
+void* cflatmap_key_at(const cflatmap *map, size_t i)
+{
+    return i < cflatmap_size(map) ? CFLATMAP_KEYS(map)[i] : NULL;
+}
+
+void* cflatmap_value_at(const cflatmap *map, size_t i)
+{
+    return i < cflatmap_size(map) ? CFLATMAP_VALS(map)[i] : NULL;
+}
+
+bool cflatmap_set(cflatmap *map, void *key, void *val)
+{
+    size_t i = cflatmap_lower_bound(map, key);
+    size_t n = cflatmap_size(map);
+
+    if(i < n && 0 == map->cmp(CFLATMAP_KEYS(map)[i], key)) {
+        cvector_replace64(&(map->keys), i, key);
+        cvector_replace64(&(map->vals), i, val);
+        return true;
+    }
+
+    cvector_insert64(&(map->keys), i, key);
+    if(cvector_size64(&(map->keys)) == n) return false;
+
+    cvector_insert64(&(map->vals), i, val);
+    if(cvector_size64(&(map->vals)) == n) {
+        cvector_pop_at64(&(map->keys), i);
+        return false;
+    }
+
+    return true;
+}
+
+void cflatmap_del(cflatmap *map, const void *key)
+{
+    ssize_t i = cflatmap_find(map, key);
+
+    if(i < 0) return;
+
+    cvector_remove_at64(&(map->keys), i);
+    cvector_remove_at64(&(map->vals), i);
+}
+
+/* ==========================================================================
+ *        bulk build
+ * ========================================================================== */
+
+static void cflatmap_insertion_sort(void **keys, void **vals, size_t n,
+                                    cobj_cb_cmp cmp)
+{
+    size_t i = 0;
+    size_t j = 0;
+    void *key = NULL;
+    void *val = NULL;
+
+    for(i = 1; i < n; ++i) {
+        key = keys[i];
+        val = vals[i];
+        for(j = i; j > 0 && cmp(keys[j - 1], key) > 0; --j) {
+            keys[j] = keys[j - 1];
+            vals[j] = vals[j - 1];
+        }
+        keys[j] = key;
+        vals[j] = val;
+    }
+}
+
+/*
+ * 把 [lo, mid) 和 [mid, hi) 归并到 dst, 相等时左边的在前 (稳定)
+ */
+static void cflatmap_merge_runs(void **dk, void **dv, void **sk, void **sv,
+                                size_t lo, size_t mid, size_t hi, cobj_cb_cmp cmp)
+{
+    size_t i = lo;
+    size_t j = mid;
+    size_t w = lo;
+
+    while(i < mid && j < hi) {
+        if(cmp(sk[j], sk[i]) < 0) {
+            dk[w] = sk[j]; dv[w++] = sv[j++];
+        } else {
+            dk[w] = sk[i]; dv[w++] = sv[i++];
+        }
+    }
+    memcpy(dk + w, sk + i, sizeof(void*) * (mid - i));
+    memcpy(dv + w, sv + i, sizeof(void*) * (mid - i));
+    w += mid - i;
+    memcpy(dk + w, sk + j, sizeof(void*) * (hi - j));
+    memcpy(dv + w, sv + j, sizeof(void*) * (hi - j));
+}
+
+/*
+ * 按 key 稳定排序 keys / vals, 相等的 key 只保留最后一个 (其余的被释放),
+ * 返回剩下的个数. tmp 至少有 2 * n 个位置.
+ */
+static size_t cflatmap_sort_unique(void **keys, void **vals, size_t n,
+                                   cobj_cb_cmp cmp, void **tmp)
+{
+    void   **sk = keys, **sv = vals;
+    void   **dk = tmp,  **dv = NULL;
+    void   **swap  = NULL;
+    size_t width = 0;
+    size_t lo    = 0;
+    size_t w     = 0;
+    size_t i     = 0;
+
+    if(0 == n) return 0;
+    dv = tmp + n;
+
+    for(lo = 0; lo < n; lo += CFLATMAP_RUN) {
+        cflatmap_insertion_sort(keys + lo, vals + lo,
+                                n - lo < CFLATMAP_RUN ? n - lo : CFLATMAP_RUN, cmp);
+    }
+
+    for(width = CFLATMAP_RUN; width < n; width *= 2) {
+        for(lo = 0; lo < n; lo += 2 * width) {
+            cflatmap_merge_runs(dk, dv, sk, sv, lo,
+                                n - lo < width ? n : lo + width,
+                                n - lo < 2 * width ? n : lo + 2 * width, cmp);
+        }
+        swap = sk; sk = dk; dk = swap;
+        swap = sv; sv = dv; dv = swap;
+    }
+
+    for(i = 0; i < n; ++i) {
+        if(i + 1 < n && 0 == cmp(sk[i], sk[i + 1])) {
+            cobj_free(sk[i]);
+            cobj_free(sv[i]);
+            continue;
+        }
+        keys[w] = sk[i];
+        vals[w] = sv[i];
+        ++w;
+    }
+
+    return w;
+}
+
+/* 排序用的临时数组, 2 * n 个位置 */
+static void** cflatmap_tmp_new(size_t n)
+{
+    if(n > (size_t)PTRDIFF_MAX / sizeof(void*) / 2) return NULL;
+
+    return (void**)malloc(sizeof(void*) * 2 * n);
+}
+
+cflatmap* cflatmap_build_from(void **keys, void **vals, size_t n, cobj_cb_cmp cmp)
+{
+    cflatmap *map = cflatmap_new(cmp);
+    void **tmp = NULL;
+
+    if(NULL == map) return NULL;
+
+    if(n > 0) {
+        tmp = cflatmap_tmp_new(n);
+        if(NULL == tmp
+           || !cvector_reserve(&(map->keys), n)
+           || !cvector_reserve(&(map->vals), n)) {
+            free(tmp);
+            cflatmap_free(map);
+            return NULL;
+        }
+    }
+
+    n = cflatmap_sort_unique(keys, vals, n, map->cmp, tmp);
+    free(tmp);
+
+    cvector_append_array64(&(map->keys), keys, n);
+    cvector_append_array64(&(map->vals), vals, n);
+    cvector_shrink_to_fit(&(map->keys));
+    cvector_shrink_to_fit(&(map->vals));
+
+    return map;
+}
+
+bool cflatmap_merge(cflatmap *map, void **keys, void **vals, size_t n)
+{
+    void   **mk = NULL;
+    void   **mv = NULL;
+    void   **tmp = NULL;
+    size_t size = cflatmap_size(map);
+    size_t i = size;
+    size_t j = 0;
+    size_t w = 0;
+    int    ret = 0;
+
+    if(0 == n) return true;
+
+    tmp = cflatmap_tmp_new(n);
+    if(NULL == tmp
+       || n > (size_t)PTRDIFF_MAX / sizeof(void*) - size
+       || !cvector_reserve(&(map->keys), size + n)
+       || !cvector_reserve(&(map->vals), size + n)) {
+        free(tmp);
+        return false;
+    }
+
+    n = cflatmap_sort_unique(keys, vals, n, map->cmp, tmp);
+    free(tmp);
+
+    /* 从后往前归并, w - i 始终不小于 j, 不会覆盖还没读取的元素 */
+    mk = CFLATMAP_KEYS(map);
+    mv = CFLATMAP_VALS(map);
+    j  = n;
+    w  = size + n;
+    while(j > 0) {
+        ret = i > 0 ? map->cmp(mk[i - 1], keys[j - 1]) : -1;
+        --w;
+        if(ret > 0) {
+            --i;
+            mk[w] = mk[i]; mv[w] = mv[i];
+        } else {
+            if(0 == ret) {
+                --i;
+                cobj_free(mk[i]);
+                cobj_free(mv[i]);
+            }
+            --j;
+            mk[w] = keys[j]; mv[w] = vals[j];
+        }
+    }
+
+    /* 重复的 key 在 [i, w) 留下空位, 把归并好的部分移到 i */
+    if(w != i) {
+        memmove(mk + i, mk + w, sizeof(void*) * (size + n - w));
+        memmove(mv + i, mv + w, sizeof(void*) * (size + n - w));
+    }
+    map->keys.size_offset = map->vals.size_offset = size + n - (w - i);
+
+    return true;
+}
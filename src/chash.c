@@ -7,6 +7,7 @@
  * =============================================================================
  }}} */
 #include <memory.h>
+#include <pthread.h>
 #include "cobj_int.h"
 #include "cobj_str.h"
 #include "chash.h"
@@ -17,6 +18,9 @@
 #include "csem.h"
 #endif
 
+/* 元素个数不超过该值时不分配桶, 直接线性查找 */
+#define CHASH_SMALL_MAX     8
+
 typedef struct chash_item
 {
     COBJ_HEAD_VARS;
@@ -31,6 +35,7 @@ typedef struct chash_bkt
 {
     chash *hash;
     clist *items;
+    uint32_t gen;   /* 与 hash->gen 不一致时, 桶内数据均已失效 */
 } chash_bkt;
 
 struct chash
@@ -44,15 +49,34 @@ struct chash
     chash_bkt *bkts;
 
     uint32_t cnt_items;
+
+    uint32_t    gen;
+    chash_item  *items_free;    /* 回收的 item, 通过 val 串成链表 */
+    /*
+     * 桶内 clist 的节点池, 释放的节点留在池中复用. 并行建表时每个线程
+     * 使用自己的池, 之后新建的桶都使用 node_pools[0]
+     */
+    clist_pool  **node_pools;
+    int         node_pools_num;
+
+    /* small 模式 (bkts == NULL) 下的数据, 个数为 cnt_items */
+    uint32_t    small_hvals[CHASH_SMALL_MAX];
+    chash_item  *small_items[CHASH_SMALL_MAX];
 };
 
 struct chash_iter
 {
     const chash *hash;
-    uint32_t bkt_idx;
+    uint32_t bkt_idx;       /* small 模式下为 small_items 的下标 */
+    uint32_t bkt_end;       /* 迭代范围为 [起始桶, bkt_end) */
     clist_iter item_iter;
 };
 
+static inline bool chash_is_small(const chash *hash)
+{
+    return NULL == hash->bkts;
+}
+
 static inline chash_item* cobj_to_item(const void *obj)
 {
     return (chash_item*)obj;
@@ -109,6 +133,71 @@ chash_item* cobj_hash_item_new(uint32_t hashval, void *key, void *val)
     return item;
 }
 
+static chash_item* chash_item_alloc(chash *hash, uint32_t hashval,
+                                    void *key, void *val)
+{
+    chash_item *item = hash->items_free;
+
+    if(NULL == item) {
+        return cobj_hash_item_new(hashval, key, val);
+    }
+
+    hash->items_free = (chash_item*)item->val;
+    item->hash_val = hashval;
+    item->key = key;
+    item->val = val;
+
+    return item;
+}
+
+static void chash_item_recycle(chash *hash, chash_item *item)
+{
+    cobj_free(item->key);
+    cobj_free(item->val);
+
+    item->key = NULL;
+    item->val = hash->items_free;
+    hash->items_free = item;
+}
+
+static void chash_items_free_release(chash *hash)
+{
+    chash_item *item = NULL;
+
+    while(hash->items_free) {
+        item = hash->items_free;
+        hash->items_free = (chash_item*)item->val;
+        free(item);
+    }
+}
+
+static inline bool chash_bkt_is_stale(const chash *hash, const chash_bkt *bkt)
+{
+    return bkt->gen != hash->gen;
+}
+
+/*
+ * 桶在 chash_reset 之后第一次被修改时, 才真正释放其中的旧数据
+ */
+static void chash_bkt_refresh(chash *hash, chash_bkt *bkt)
+{
+    chash_item *item = NULL;
+
+    if(!chash_bkt_is_stale(hash, bkt)) return;
+
+    while((item = (chash_item*)clist_pop_front(bkt->items)) != NULL) {
+        chash_item_recycle(hash, item);
+    }
+    bkt->gen = hash->gen;
+}
+
+static uint32_t chash_bkt_get_item_num(const chash_bkt *bkt)
+{
+    if(chash_bkt_is_stale(bkt->hash, bkt)) return 0;
+
+    return clist_size(bkt->items);
+}
+
 uint32_t cobj_hash_item_hashval(const chash_item *item)
 {
     return item->hash_val;
@@ -136,63 +225,105 @@ void cobj_hash_item_set(chash_item *item, void *key, void *val)
 }
 
 
+static chash_item* chash_iter_item(chash_iter *itor)
+{
+    if(chash_iter_is_end(itor)) {
+        return NULL;
+    } else if(chash_is_small(itor->hash)) {
+        return itor->hash->small_items[itor->bkt_idx];
+    } else {
+        return (chash_item*)clist_iter_obj(&(itor->item_iter));
+    }
+}
+
 bool chash_iter_is_end(chash_iter *itor)
 {
-    return itor->bkt_idx == (itor->hash->bkts_num);
+    return itor->bkt_idx >= itor->bkt_end;
 }
 
-chash_iter* chash_iter_next(chash_iter *itor)
+/*
+ * 从 bkt_first 开始查找第一个非空的桶, 找不到时指向 bkt_end
+ */
+static void chash_iter_seek(chash_iter *itor, uint32_t bkt_first)
 {
     uint32_t bkt_idx  = 0;
     chash_bkt *bkt  = NULL;
-    const chash       *hash = NULL;
-    bool is_exsit_next = false;
 
-    hash = itor->hash;
-    clist_iter_to_next(&(itor->item_iter));
+    for (bkt_idx = bkt_first; bkt_idx < itor->bkt_end; bkt_idx++) {
+        bkt = &(itor->hash->bkts[bkt_idx]);
 
-    if(!clist_iter_is_end(&(itor->item_iter))) {
-        is_exsit_next = true;
-    } else {
-        for (bkt_idx = itor->bkt_idx + 1; bkt_idx < hash->bkts_num; bkt_idx++) {
-            bkt = &(hash->bkts[bkt_idx]);
-
-            if(clist_size(bkt->items) > 0) {
-                itor->bkt_idx   = bkt_idx;
-                itor->item_iter = clist_begin(bkt->items);
-                is_exsit_next   = true;
-                break;
-            }
+        if(chash_bkt_get_item_num(bkt) > 0) {
+            itor->bkt_idx   = bkt_idx;
+            itor->item_iter = clist_begin(bkt->items);
+            return;
         }
     }
 
-    if(!is_exsit_next) {
-        itor->bkt_idx = hash->bkts_num;
+    itor->bkt_idx = itor->bkt_end;
+}
+
+chash_iter* chash_iter_next(chash_iter *itor)
+{
+    if(chash_iter_is_end(itor)) {
+        return itor;
+    } else if(chash_is_small(itor->hash)) {
+        ++itor->bkt_idx;
+        return itor;
+    }
+
+    clist_iter_to_next(&(itor->item_iter));
+    if(clist_iter_is_end(&(itor->item_iter))) {
+        chash_iter_seek(itor, itor->bkt_idx + 1);
     }
 
     return itor;
 }
 
-chash_iter* chash_iter_new(const chash *hash)
+static inline uint32_t chash_part_of_bkt(uint32_t bkt_idx, uint32_t bkts_num, int nparts)
 {
-    uint32_t bkt_idx = 0;
-    chash_bkt *bkt = NULL;
+    return (uint32_t)(((uint64_t)bkt_idx * nparts) / bkts_num);
+}
 
-    chash_iter *itor = (chash_iter*)calloc(1, sizeof(chash_iter));
+static inline uint32_t chash_part_first_bkt(int part, uint32_t bkts_num, int nparts)
+{
+    return (uint32_t)(((uint64_t)part * bkts_num + nparts - 1) / nparts);
+}
 
-    itor->hash    = hash;
-    itor->bkt_idx = hash->bkts_num;
+static void chash_iter_init_part(chash_iter *itor, const chash *hash,
+                                 int part, int nparts)
+{
+    memset(itor, 0, sizeof(chash_iter));
+    itor->hash = hash;
 
-    for (bkt_idx = 0; bkt_idx < hash->bkts_num; bkt_idx++) {
-        bkt = &(hash->bkts[bkt_idx]);
+    if(chash_is_small(hash)) {
+        /* small 模式的数据全部归入第 0 个分区 */
+        itor->bkt_end = part == 0 ? hash->cnt_items : 0;
+        itor->bkt_idx = 0;
+    } else {
+        itor->bkt_end = chash_part_first_bkt(part + 1, hash->bkts_num, nparts);
+        chash_iter_seek(itor, chash_part_first_bkt(part, hash->bkts_num, nparts));
+    }
+}
 
-        if(clist_size(bkt->items) > 0) {
-            itor->bkt_idx   = bkt_idx;
-            itor->item_iter = clist_begin(bkt->items);
-            break;
-        }
+chash_iter* chash_iter_new(const chash *hash)
+{
+    return chash_partition_iter(hash, 0, 1);
+}
+
+chash_iter* chash_partition_iter(const chash *hash, int part, int nparts)
+{
+    chash_iter *itor = NULL;
+
+    if(nparts <= 0 || part < 0 || part >= nparts) {
+        printf("[CHASH]invalid partition(%d/%d)\n", part, nparts);
+        return NULL;
     }
 
+    itor = (chash_iter*)calloc(1, sizeof(chash_iter));
+    if(NULL == itor) return NULL;
+
+    chash_iter_init_part(itor, hash, part, nparts);
+
     return itor;
 }
 
@@ -203,20 +334,16 @@ void chash_iter_free(chash_iter *itor)
 
 void* chash_iter_key(chash_iter *itor)
 {
-    if(!clist_iter_is_end(&(itor->item_iter))) {
-        return clist_iter_obj(&(itor->item_iter));
-    }
+    chash_item *item = chash_iter_item(itor);
 
-    return NULL;
+    return item ? cobj_hash_item_key(item) : NULL;
 }
 
 void* chash_iter_value(chash_iter *itor)
 {
-    if(!clist_iter_is_end(&(itor->item_iter))) {
-        return cobj_hash_item_value((chash_item*)clist_iter_obj(&(itor->item_iter)));
-    }
+    chash_item *item = chash_iter_item(itor);
 
-    return NULL;
+    return item ? cobj_hash_item_value(item) : NULL;
 }
 
 inline static uint32_t hash_val_to_bkt(uint32_t hash_val, uint32_t bkts_num)
@@ -235,23 +362,57 @@ static chash_bkt* chash_get_bkt(const chash *hash, uint32_t hash_val)
     return &(hash->bkts[bkt_idx]);
 }
 
-static uint32_t chash_bkt_get_item_num(const chash_bkt *bkt)
+/* 第 idx 个节点池, 不存在时返回 NULL (节点使用 malloc/free) */
+static clist_pool* chash_node_pool(const chash *hash, int idx)
 {
-    return clist_size(bkt->items);
+    return idx < hash->node_pools_num ? hash->node_pools[idx] : NULL;
 }
 
-static chash_bkt* chash_bkts_new(chash *hash)
+/*
+ * 准备 num 个节点池 (并行建表时每个线程一个), 失败时多出的部分不使用
+ * 节点池, 节点直接 malloc/free
+ */
+static void chash_node_pools_reserve(chash *hash, int num)
+{
+    clist_pool **pools = NULL;
+
+    if(num <= hash->node_pools_num) return;
+
+    pools = (clist_pool**)realloc(hash->node_pools, sizeof(clist_pool*) * num);
+    if(NULL == pools) return;
+
+    hash->node_pools = pools;
+    while(hash->node_pools_num < num) {
+        pools[hash->node_pools_num] = clist_pool_new(0);
+        if(NULL == pools[hash->node_pools_num]) break;
+        ++hash->node_pools_num;
+    }
+}
+
+static void chash_bkts_init(chash *hash, chash_bkt *bkts,
+                            uint32_t first, uint32_t last, clist_pool *pool)
 {
-    chash_bkt *bkts = NULL;
     chash_bkt *bkt  = NULL;
     uint32_t i = 0;
 
-    bkts = (chash_bkt*)calloc(hash->bkts_num, sizeof(chash_bkt));
-    for (i = 0; i < hash->bkts_num; i++) {
+    for (i = first; i < last; i++) {
         bkt = &(bkts[i]);
         bkt->hash  = hash;
-        bkt->items = clist_new();
+        bkt->items = clist_new_with_pool(pool);
+        clist_set_lock_type(bkt->items, CLIST_LOCK_NONE);
+        bkt->gen   = hash->gen;
     }
+}
+
+static chash_bkt* chash_bkts_new(chash *hash)
+{
+    chash_bkt *bkts = NULL;
+
+    /* 节点池在第一次分配桶时才创建, small 模式的表不需要 */
+    chash_node_pools_reserve(hash, 1);
+
+    bkts = (chash_bkt*)calloc(hash->bkts_num, sizeof(chash_bkt));
+    chash_bkts_init(hash, bkts, 0, hash->bkts_num, chash_node_pool(hash, 0));
 
     return bkts;
 }
@@ -260,17 +421,61 @@ chash *chash_new(void)
 {
     chash *hash = (chash*)calloc(1, sizeof(chash));
 
-    hash->bkts_num = 32;
-    hash->bkts_num_log2 = 5;
 #ifdef CHASH_ENABLE_SEM
     hash->mutex = cmutex_new();
 #endif
 
-    hash->bkts = chash_bkts_new(hash);
+    /* 初始为 small 模式, 元素超过 CHASH_SMALL_MAX 后再分配桶 */
+    hash->bkts = NULL;
 
     return hash;
 }
 
+/*
+ * small 模式转为桶模式
+ */
+static void chash_promote(chash *hash)
+{
+    uint32_t i = 0;
+    chash_item *item = NULL;
+
+    hash->bkts_num = 32;
+    hash->bkts_num_log2 = 5;
+    hash->bkts = chash_bkts_new(hash);
+
+    for (i = 0; i < hash->cnt_items; i++) {
+        item = hash->small_items[i];
+        clist_append(chash_get_bkt(hash, item->hash_val)->items, item);
+        hash->small_items[i] = NULL;
+    }
+}
+
+static int chash_small_find(const chash *hash, uint32_t hash_val, const void *key)
+{
+    uint32_t i = 0;
+
+    for (i = 0; i < hash->cnt_items; i++) {
+        if(hash->small_hvals[i] != hash_val) continue;
+        if(cobj_equal(cobj_hash_item_key(hash->small_items[i]), key)) {
+            return (int)i;
+        }
+    }
+
+    return -1;
+}
+
+static void chash_small_del_at(chash *hash, uint32_t idx)
+{
+    chash_item_recycle(hash, hash->small_items[idx]);
+
+    --hash->cnt_items;
+    for (; idx < hash->cnt_items; idx++) {
+        hash->small_items[idx] = hash->small_items[idx + 1];
+        hash->small_hvals[idx] = hash->small_hvals[idx + 1];
+    }
+    hash->small_items[hash->cnt_items] = NULL;
+}
+
 uint32_t chash_count(const chash *hash)
 {
     return hash->cnt_items;
@@ -292,8 +497,16 @@ void chash_free(chash *hash)
             bkt = &(hash->bkts[i]);
             clist_free(bkt->items);
         }
+        if(chash_is_small(hash)) {
+            chash_clear(hash);
+        }
 
         free(hash->bkts);
+        chash_items_free_release(hash);
+        for (i = 0; i < (uint32_t)hash->node_pools_num; i++) {
+            clist_pool_free(hash->node_pools[i]);
+        }
+        free(hash->node_pools);
         free(hash);
     }
 }
@@ -304,9 +517,36 @@ void chash_clear(chash *hash)
     uint32_t i = 0;
     chash_bkt *bkt     = NULL;
 
+    if(chash_is_small(hash)) {
+        for (i = 0; i < hash->cnt_items; i++) {
+            cobj_free(hash->small_items[i]);
+            hash->small_items[i] = NULL;
+        }
+    }
+
     for (i = 0; i < bkts_num; i++) {
         bkt = &(hash->bkts[i]);
         clist_clear(bkt->items);
+        bkt->gen = hash->gen;
+    }
+    hash->cnt_items = 0;
+}
+
+void chash_reset(chash *hash)
+{
+    /* small 模式最多 CHASH_SMALL_MAX 个元素, 直接回收 */
+    if(chash_is_small(hash)) {
+        while(hash->cnt_items > 0) {
+            chash_small_del_at(hash, hash->cnt_items - 1);
+        }
+        return;
+    }
+
+    hash->cnt_items = 0;
+
+    /* gen 回绕后旧桶可能被误认为有效, 此时退化为完整清除 */
+    if(++hash->gen == 0) {
+        chash_clear(hash);
     }
 }
 
@@ -327,6 +567,8 @@ static clist_iter bkt_find_item_node(chash_bkt* bkt, uint32_t hash_val, const vo
     chash_item *item = NULL;
     clist_iter iter = clist_begin(bkt->items);
 
+    if(chash_bkt_is_stale(bkt->hash, bkt)) return clist_end(bkt->items);
+
     clist_iter_foreach_obj(&iter, item) {
         /* hash 值不一致肯定不是 */
         if(cobj_hash_item_hashval(item) != hash_val) continue;
@@ -345,20 +587,26 @@ static chash_item* bkt_find_item(chash_bkt* bkt, uint32_t hash_val, const void *
     return (chash_item*)clist_iter_obj(&iter);
 }
 
-bool chash_haskey(const chash *hash, const void *key)
+static chash_item* chash_find_item(const chash *hash, uint32_t hash_val, const void *key)
 {
-    uint32_t    hash_val = 0;
-    chash_bkt *bkt     = 0;
+    int idx = 0;
 
-    hash_val = cobj_hash(key);
-    bkt = chash_get_bkt(hash, hash_val);
+    if(chash_is_small(hash)) {
+        idx = chash_small_find(hash, hash_val, key);
+        return idx >= 0 ? hash->small_items[idx] : NULL;
+    }
 
-    return bkt_find_item(bkt, hash_val, key) != NULL;
+    return bkt_find_item(chash_get_bkt(hash, hash_val), hash_val, key);
+}
+
+bool chash_haskey(const chash *hash, const void *key)
+{
+    return chash_find_item(hash, cobj_hash(key), key) != NULL;
 }
 
 static chash_item *bkt_add(chash_bkt *bkt, uint32_t hashval, void *key, void *val)
 {/*{{{*/
-    chash_item *item = cobj_hash_item_new(hashval, key, val);
+    chash_item *item = chash_item_alloc(bkt->hash, hashval, key, val);
 
     clist_append(bkt->items, item);
 
@@ -400,6 +648,7 @@ static void chash_adjust(chash *hash)
     hash->bkts = chash_bkts_new(hash);
     for (bkt_idx_old = 0; bkt_idx_old < bkts_num_old; bkt_idx_old++) {
         bkt_old = &(bkts_old[bkt_idx_old]);
+        chash_bkt_refresh(hash, bkt_old);
 
         iter = clist_begin(bkt_old->items);
         while(!clist_iter_is_end(&iter)) {
@@ -427,7 +676,24 @@ void chash_set(chash *hash, void  *key,  void *val)
     chash_item *item = NULL;
 
     hash_val = cobj_hash(key);
+
+    if(chash_is_small(hash)) {
+        item = chash_find_item(hash, hash_val, key);
+        if(item) {
+            cobj_hash_item_set(item, key, val);
+            return;
+        } else if(hash->cnt_items < CHASH_SMALL_MAX) {
+            hash->small_hvals[hash->cnt_items] = hash_val;
+            hash->small_items[hash->cnt_items] = chash_item_alloc(hash, hash_val, key, val);
+            ++hash->cnt_items;
+            return;
+        }
+
+        chash_promote(hash);
+    }
+
     bkt      = chash_get_bkt(hash, hash_val);
+    chash_bkt_refresh(hash, bkt);
 
     item = bkt_find_item(bkt, hash_val, key);
     if(NULL == item) {
@@ -449,16 +715,14 @@ void chash_set(chash *hash, void  *key,  void *val)
 void* chash_get_value(chash *hash, const void *key)
 {
     uint32_t  hash_val = 0;
-    chash_bkt  *bkt  = NULL;
     chash_item *item = NULL;
 
     hash_val = cobj_hash(key);
-    bkt      = chash_get_bkt(hash, hash_val);
 
     /* cobj_print(key); */
     /* printf(" hash_val:%08X\n", hash_val); */
 
-    item = bkt_find_item(bkt, hash_val, key);
+    item = chash_find_item(hash, hash_val, key);
 
     return item ? cobj_hash_item_value(item) : NULL;
 }
@@ -467,13 +731,427 @@ void chash_del(chash *hash, const void *key)
 {
     uint32_t  hash_val = 0;
     chash_bkt  *bkt = NULL;
+    int idx = 0;
 
     hash_val = cobj_hash(key);
+
+    if(chash_is_small(hash)) {
+        idx = chash_small_find(hash, hash_val, key);
+        if(idx >= 0) {
+            chash_small_del_at(hash, idx);
+        }
+        return;
+    }
+
     bkt      = chash_get_bkt(hash, hash_val);
+    chash_bkt_refresh(hash, bkt);
 
     bkt_del(hash, bkt, hash_val, key);
 }
 
+/* ==========================================================================
+ *        parallel build
+ * ========================================================================== */
+typedef struct chash_build_ctx
+{
+    chash       *hash;
+    void        **keys;
+    void        **vals;
+    uint32_t    n;
+    int         nthreads;
+    uint32_t    *hvals;     /* 每个 key 的 hash 值 */
+    uint32_t    *order;     /* 按分区重排后的下标 */
+    uint32_t    *counts;    /* [线程][分区] 的元素个数, 之后转为写入偏移 */
+    uint32_t    *parts;     /* 分区 p 在 order 中的范围为 [parts[p], parts[p + 1]) */
+} chash_build_ctx;
+
+typedef struct chash_build_task
+{
+    chash_build_ctx *ctx;
+    int         idx;
+    int         phase;
+    uint32_t    cnt_items;
+} chash_build_task;
+
+/*
+ * 在 nthreads 个线程上分别执行 fn(&tasks[i]), 线程创建失败时在当前线程执行
+ */
+static void chash_run_parallel(void *(*fn)(void*), void *tasks,
+                               size_t task_size, int nthreads)
+{
+    pthread_t *tids    = (pthread_t*)calloc(nthreads, sizeof(pthread_t));
+    bool      *started = (bool*)calloc(nthreads, sizeof(bool));
+    int i = 0;
+
+    for (i = 1; i < nthreads; i++) {
+        started[i] = pthread_create(&tids[i], NULL, fn,
+                                    (char*)tasks + task_size * i) == 0;
+    }
+
+    fn(tasks);
+    for (i = 1; i < nthreads; i++) {
+        if(started[i]) {
+            pthread_join(tids[i], NULL);
+        } else {
+            fn((char*)tasks + task_size * i);
+        }
+    }
+
+    free(started);
+    free(tids);
+}
+
+static void *chash_build_worker(void *arg)
+{
+    chash_build_task *task = (chash_build_task*)arg;
+    chash_build_ctx  *ctx  = task->ctx;
+    chash       *hash  = ctx->hash;
+    uint32_t    *cnts  = ctx->counts + (size_t)task->idx * ctx->nthreads;
+    uint32_t    first  = (uint32_t)(((uint64_t)ctx->n * task->idx) / ctx->nthreads);
+    uint32_t    last   = (uint32_t)(((uint64_t)ctx->n * (task->idx + 1)) / ctx->nthreads);
+    uint32_t    i      = 0;
+    uint32_t    part   = 0;
+    uint32_t    bkt_idx = 0;
+    chash_bkt   *bkt   = NULL;
+    chash_item  *item  = NULL;
+
+    switch(task->phase) {
+        case 0:
+            /* 计算 hash 值并统计各分区的元素个数 */
+            for (i = first; i < last; i++) {
+                ctx->hvals[i] = cobj_hash(ctx->keys[i]);
+                bkt_idx = hash_val_to_bkt(ctx->hvals[i], hash->bkts_num);
+                ++cnts[chash_part_of_bkt(bkt_idx, hash->bkts_num, ctx->nthreads)];
+            }
+            break;
+        case 1:
+            /* 按分区分发下标, 同一分区内保持输入顺序 */
+            for (i = first; i < last; i++) {
+                bkt_idx = hash_val_to_bkt(ctx->hvals[i], hash->bkts_num);
+                part = chash_part_of_bkt(bkt_idx, hash->bkts_num, ctx->nthreads);
+                ctx->order[cnts[part]++] = i;
+            }
+            break;
+        default:
+            /* 每个线程独占一段桶, 无需加锁 */
+            chash_bkts_init(hash, hash->bkts,
+                    chash_part_first_bkt(task->idx, hash->bkts_num, ctx->nthreads),
+                    chash_part_first_bkt(task->idx + 1, hash->bkts_num, ctx->nthreads),
+                    chash_node_pool(hash, task->idx));
+
+            for (first = ctx->parts[task->idx];
+                 first < ctx->parts[task->idx + 1]; first++) {
+                i    = ctx->order[first];
+                bkt  = chash_get_bkt(hash, ctx->hvals[i]);
+                item = bkt_find_item(bkt, ctx->hvals[i], ctx->keys[i]);
+                if(item) {
+                    cobj_hash_item_set(item, ctx->keys[i], ctx->vals[i]);
+                } else {
+                    item = cobj_hash_item_new(ctx->hvals[i], ctx->keys[i], ctx->vals[i]);
+                    clist_append(bkt->items, item);
+                    ++task->cnt_items;
+                }
+            }
+            break;
+    }
+
+    return NULL;
+}
+
+chash* chash_build_from(void **keys, void **vals, uint32_t n, int nthreads)
+{
+    chash *hash = chash_new();
+    chash_build_ctx  ctx;
+    chash_build_task *tasks = NULL;
+    uint32_t offset = 0;
+    uint32_t cnt    = 0;
+    int t = 0;
+    int p = 0;
+
+    if(nthreads < 1) nthreads = 1;
+
+    if(n <= CHASH_SMALL_MAX) {
+        for (offset = 0; offset < n; offset++) {
+            chash_set(hash, keys[offset], vals[offset]);
+        }
+        return hash;
+    }
+
+    /* 按 n 预分配桶, 之后不再需要 chash_adjust */
+    hash->bkts_num = 32;
+    hash->bkts_num_log2 = 5;
+    while(hash->bkts_num < n && hash->bkts_num < 0x80000000u) {
+        hash->bkts_num <<= 1;
+        ++hash->bkts_num_log2;
+    }
+    hash->bkts = (chash_bkt*)calloc(hash->bkts_num, sizeof(chash_bkt));
+
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.hash     = hash;
+    ctx.keys     = keys;
+    ctx.vals     = vals;
+    ctx.n        = n;
+    ctx.nthreads = nthreads;
+    ctx.hvals    = (uint32_t*)malloc(sizeof(uint32_t) * n);
+    ctx.order    = (uint32_t*)malloc(sizeof(uint32_t) * n);
+    ctx.counts   = (uint32_t*)calloc((size_t)nthreads * nthreads, sizeof(uint32_t));
+    ctx.parts    = (uint32_t*)calloc(nthreads + 1, sizeof(uint32_t));
+
+    tasks = (chash_build_task*)calloc(nthreads, sizeof(chash_build_task));
+    for (t = 0; t < nthreads; t++) {
+        tasks[t].ctx = &ctx;
+        tasks[t].idx = t;
+    }
+
+    chash_run_parallel(chash_build_worker, tasks, sizeof(chash_build_task), nthreads);
+
+    /* 计数转为写入偏移: 分区优先, 同分区内按线程顺序 */
+    for (p = 0; p < nthreads; p++) {
+        ctx.parts[p] = offset;
+        for (t = 0; t < nthreads; t++) {
+            cnt = ctx.counts[(size_t)t * nthreads + p];
+            ctx.counts[(size_t)t * nthreads + p] = offset;
+            offset += cnt;
+        }
+    }
+    ctx.parts[nthreads] = offset;
+
+    for (t = 0; t < nthreads; t++) tasks[t].phase = 1;
+    chash_run_parallel(chash_build_worker, tasks, sizeof(chash_build_task), nthreads);
+
+    /* 每个线程从自己的节点池分配, 节点池本身不加锁 */
+    chash_node_pools_reserve(hash, nthreads);
+    for (t = 0; t < nthreads; t++) tasks[t].phase = 2;
+    chash_run_parallel(chash_build_worker, tasks, sizeof(chash_build_task), nthreads);
+
+    for (t = 0; t < nthreads; t++) {
+        hash->cnt_items += tasks[t].cnt_items;
+    }
+
+    free(tasks);
+    free(ctx.parts);
+    free(ctx.counts);
+    free(ctx.order);
+    free(ctx.hvals);
+
+    return hash;
+}
+
+/* ==========================================================================
+ *        parallel scan
+ * ========================================================================== */
+typedef struct chash_scan_task
+{
+    chash       *hash;
+    int         idx;
+    int         nthreads;
+    chash_cb_foreach    fn_each;
+    chash_cb_match      fn_match;
+    void        *arg;       /* reduce 时为该线程的累加结果 */
+    uint32_t    cnt_removed;
+    /*
+     * remove_if 删除的节点先移到这里, 每个节点池一个 (最后一个为不使用
+     * 节点池的桶), 同一节点池之间移动只修改指针, 线程结束后再统一释放
+     */
+    clist       **removed;
+} chash_scan_task;
+
+/* 桶使用的节点池在 removed 中的下标 */
+static int chash_node_pool_idx(const chash *hash, const clist_pool *pool)
+{
+    int i = 0;
+
+    for (i = 0; i < hash->node_pools_num; i++) {
+        if(hash->node_pools[i] == pool) return i;
+    }
+
+    return hash->node_pools_num;
+}
+
+static void chash_scan_remove_if(chash_scan_task *task)
+{
+    chash       *hash = task->hash;
+    uint32_t    bkt_idx  = 0;
+    uint32_t    bkt_last = 0;
+    chash_bkt   *bkt  = NULL;
+    chash_item  *item = NULL;
+    clist       **removed = NULL;
+    clist_iter  iter;
+    clist_iter  iter_del;
+
+    bkt_idx  = chash_part_first_bkt(task->idx, hash->bkts_num, task->nthreads);
+    bkt_last = chash_part_first_bkt(task->idx + 1, hash->bkts_num, task->nthreads);
+    for (; bkt_idx < bkt_last; bkt_idx++) {
+        bkt = &(hash->bkts[bkt_idx]);
+        if(chash_bkt_is_stale(hash, bkt)) continue;
+
+        iter = clist_begin(bkt->items);
+        while(!clist_iter_is_end(&iter)) {
+            iter_del = iter;
+            item = (chash_item*)clist_iter_obj(&iter);
+            clist_iter_to_next(&iter);
+
+            if(!task->fn_match(item->key, item->val, task->arg)) continue;
+
+            removed = &(task->removed[chash_node_pool_idx(hash, bkt->items->pool)]);
+            if(NULL == *removed) {
+                *removed = clist_new_with_pool(bkt->items->pool);
+                if(NULL == *removed) continue;
+                clist_set_lock_type(*removed, CLIST_LOCK_NONE);
+            }
+            clist_splice(*removed, NULL, bkt->items, &iter_del, &iter);
+            ++task->cnt_removed;
+        }
+    }
+}
+
+static void *chash_scan_worker(void *arg)
+{
+    chash_scan_task *task = (chash_scan_task*)arg;
+    chash_iter  itor;
+    chash_item  *item = NULL;
+
+    if(task->fn_match) {
+        chash_scan_remove_if(task);
+        return NULL;
+    }
+
+    chash_iter_init_part(&itor, task->hash, task->idx, task->nthreads);
+    while(!chash_iter_is_end(&itor)) {
+        item = chash_iter_item(&itor);
+        task->fn_each(item->key, item->val, task->arg);
+        chash_iter_next(&itor);
+    }
+
+    return NULL;
+}
+
+static chash_scan_task* chash_scan_tasks_new(chash *hash, int nthreads)
+{
+    chash_scan_task *tasks = NULL;
+    int i = 0;
+
+    tasks = (chash_scan_task*)calloc(nthreads, sizeof(chash_scan_task));
+    for (i = 0; i < nthreads; i++) {
+        tasks[i].hash     = hash;
+        tasks[i].idx      = i;
+        tasks[i].nthreads = nthreads;
+    }
+
+    return tasks;
+}
+
+/* 释放前 n 个 task 删除的节点和 tasks 本身 */
+static void chash_scan_tasks_free(chash_scan_task *tasks, int n)
+{
+    int i = 0;
+    int k = 0;
+
+    for (i = 0; i < n; i++) {
+        for (k = 0; tasks[i].removed && k <= tasks[i].hash->node_pools_num; k++) {
+            if(tasks[i].removed[k]) clist_free(tasks[i].removed[k]);
+        }
+        free(tasks[i].removed);
+    }
+    free(tasks);
+}
+
+void chash_parallel_for_each(const chash *hash, chash_cb_foreach fn,
+                             void *arg, int nthreads)
+{
+    chash_scan_task *tasks = NULL;
+    int i = 0;
+
+    if(nthreads < 1 || chash_is_small(hash)) nthreads = 1;
+
+    tasks = chash_scan_tasks_new((chash*)hash, nthreads);
+    for (i = 0; i < nthreads; i++) {
+        tasks[i].fn_each = fn;
+        tasks[i].arg     = arg;
+    }
+
+    chash_run_parallel(chash_scan_worker, tasks, sizeof(chash_scan_task), nthreads);
+
+    free(tasks);
+}
+
+void chash_parallel_reduce(const chash *hash, chash_cb_foreach fn,
+                           chash_cb_merge fn_merge, void *result,
+                           size_t result_size, int nthreads)
+{
+    chash_scan_task *tasks = NULL;
+    char *accs = NULL;
+    int i = 0;
+
+    if(nthreads < 1 || chash_is_small(hash)) nthreads = 1;
+
+    /* 每个线程从 result 的初始值 (单位元) 开始累加 */
+    accs  = (char*)malloc(result_size * nthreads);
+    tasks = chash_scan_tasks_new((chash*)hash, nthreads);
+    for (i = 0; i < nthreads; i++) {
+        memcpy(accs + result_size * i, result, result_size);
+        tasks[i].fn_each = fn;
+        tasks[i].arg     = accs + result_size * i;
+    }
+
+    chash_run_parallel(chash_scan_worker, tasks, sizeof(chash_scan_task), nthreads);
+
+    memcpy(result, accs, result_size);
+    for (i = 1; i < nthreads; i++) {
+        fn_merge(result, accs + result_size * i);
+    }
+
+    free(tasks);
+    free(accs);
+}
+
+uint32_t chash_parallel_remove_if(chash *hash, chash_cb_match fn,
+                                  void *arg, int nthreads)
+{
+    chash_scan_task *tasks = NULL;
+    chash_item *item = NULL;
+    uint32_t cnt_removed = 0;
+    uint32_t i = 0;
+
+    if(chash_is_small(hash)) {
+        while(i < hash->cnt_items) {
+            item = hash->small_items[i];
+            if(fn(item->key, item->val, arg)) {
+                chash_small_del_at(hash, i);
+                ++cnt_removed;
+            } else {
+                ++i;
+            }
+        }
+        return cnt_removed;
+    }
+
+    if(nthreads < 1) nthreads = 1;
+
+    tasks = chash_scan_tasks_new(hash, nthreads);
+    for (i = 0; i < (uint32_t)nthreads; i++) {
+        tasks[i].fn_match = fn;
+        tasks[i].arg      = arg;
+        tasks[i].removed  = (clist**)calloc(hash->node_pools_num + 1, sizeof(clist*));
+        if(NULL == tasks[i].removed) {
+            chash_scan_tasks_free(tasks, i);
+            return 0;
+        }
+    }
+
+    chash_run_parallel(chash_scan_worker, tasks, sizeof(chash_scan_task), nthreads);
+
+    for (i = 0; i < (uint32_t)nthreads; i++) {
+        cnt_removed += tasks[i].cnt_removed;
+    }
+    hash->cnt_items -= cnt_removed;
+
+    /* 节点池不加锁, 在这里单线程释放删除的 item 并回收节点 */
+    chash_scan_tasks_free(tasks, nthreads);
+
+    return cnt_removed;
+}
+
 void chash_printf_test(const chash *hash, FILE *file)
 {
     uint32_t i = 0;
@@ -489,9 +1167,20 @@ void chash_printf_test(const chash *hash, FILE *file)
     fprintf(file, "bkt num:%d item cnt:%d\n",
                   chash_get_bkts_num(hash), hash->cnt_items);
 
+    if(chash_is_small(hash)) {
+        for (i = 0; i < hash->cnt_items; i++) {
+            fprintf(file, "    |-item:%d ", i);
+            fprintf(file, " hash:0x%08X", hash->small_hvals[i]);
+            fprintf(file, " key:");
+            cobj_print(hash->small_items[i]);
+            fprintf(file, "\n");
+        }
+    }
+
     for (i = 0; i < chash_get_bkts_num(hash); i++) {
         bkt = &(hash->bkts[i]);
-        fprintf(file, "  |-bkt idx:%d, item cnt:%d\n", i, clist_size(bkt->items));
+        fprintf(file, "  |-bkt idx:%d, item cnt:%d\n", i, chash_bkt_get_item_num(bkt));
+        if(chash_bkt_is_stale(hash, bkt)) continue;
 
         idx_item = 0;
         clist_foreach_val(bkt->items, node, item) {
@@ -515,7 +1204,7 @@ void chash_printf(const chash *hash, FILE *file)
 
     itor = chash_iter_new(hash);
     while(!chash_iter_is_end(itor)){
-        cobj_fprint(clist_iter_obj(&(itor->item_iter)), file);
+        cobj_fprint(chash_iter_item(itor), file);
 
         ++idx_item;
         if(idx_item < hash->cnt_items) {
@@ -539,7 +1228,7 @@ void chash_to_cstr(const chash *hash, cstr *str)
 
     itor = chash_iter_new(hash);
     while(!chash_iter_is_end(itor)){
-        str_item = cobj_to_cstr(clist_iter_obj(&(itor->item_iter)));
+        str_item = cobj_to_cstr(chash_iter_item(itor));
         cstr_add(str, str_item);
         cstr_free(str_item);
 
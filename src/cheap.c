@@ -0,0 +1,337 @@
+/* {{{
+ * =============================================================================
+ *      Filename    :   cheap.c
+ *      Description :
+ *      Created     :   2026-10-19 23:10:41
+ *      Author      :   Wu Hong
+ * =============================================================================
+ }}} */
+#include <stdint.h>
+#include "cheap.h"
+
+#define CHEAP_HANDLES_INIT  16
+#define CHEAP_SHIFT_MAX     4       /* 最多 16 叉 */
+
+struct cheap
+{
+    cvector      objs;          /* 堆数组 */
+    size_t       *ids;          /* ids[i]: 位置 i 的元素的 handle */
+    size_t       *pos;          /* pos[h]: handle h 的位置, 空闲时为下一个空闲的 handle */
+    size_t       handle_alloc;  /* ids 和 pos 的大小 */
+    size_t       handle_used;   /* 分配过的 handle 个数 */
+    cheap_handle handle_free;   /* 空闲 handle 链表 */
+    cobj_cb_cmp  cmp;
+    unsigned int shift;         /* d = 1 << shift */
+};
+
+#define CHEAP_OBJS(heap) ((heap)->objs.objs)
+
+#define CHEAP_SET(heap, i, obj, id) \
+    do {    \
+        CHEAP_OBJS(heap)[i] = (obj);    \
+        (heap)->ids[i] = (id);  \
+        (heap)->pos[id] = (i);  \
+    }while(0)
+
+cheap* cheap_new_dary(cobj_cb_cmp cmp, unsigned int d)
+{
+    cheap *heap = NULL;
+    unsigned int shift = 0;
+
+    while(shift <= CHEAP_SHIFT_MAX && (1u << shift) < d) ++shift;
+    if(d < 2 || shift > CHEAP_SHIFT_MAX || (1u << shift) != d) {
+        printf("[CHEAP]invalid d(%u)\n", d);
+        return NULL;
+    }
+
+    heap = (cheap*)calloc(1, sizeof(cheap));
+    if(NULL == heap) return NULL;
+
+    cvector_init(&(heap->objs));
+    heap->handle_free = CHEAP_HANDLE_NONE;
+    heap->cmp   = cmp ? cmp : cobj_cmp;
+    heap->shift = shift;
+
+    return heap;
+}
+
+cheap* cheap_new(cobj_cb_cmp cmp)
+{
+    return cheap_new_dary(cmp, 2);
+}
+
+void cheap_free(cheap *heap)
+{
+    if(heap) {
+        cvector_release(&(heap->objs));
+        free(heap->ids);
+        free(heap->pos);
+        free(heap);
+    }
+}
+
+void cheap_clear(cheap *heap)
+{
+    cvector_clear(&(heap->objs));
+    heap->handle_used = 0;
+    heap->handle_free = CHEAP_HANDLE_NONE;
+}
+
+void cheap_print(const cheap *heap)
+{
+    cvector_print(&(heap->objs));
+}
+
+bool cheap_is_empty(const cheap *heap)
+{
+    return cvector_is_empty(&(heap->objs));
+}
+
+size_t cheap_size(const cheap *heap)
+{
+    return cvector_size64(&(heap->objs));
+}
+
+/*
+ * ids 和 pos 至少能放下 n 个 handle
+ */
+static bool cheap_reserve_handles(cheap *heap, size_t n)
+{
+    size_t size = heap->handle_alloc;
+    size_t *ids = NULL;
+    size_t *pos = NULL;
+
+    if(n <= heap->handle_alloc) return true;
+    if(n > SIZE_MAX / 2 / sizeof(size_t)) return false;
+
+    size *= 2;
+    if(size < CHEAP_HANDLES_INIT) size = CHEAP_HANDLES_INIT;
+    if(size < n) size = n;
+
+    ids = (size_t*)realloc(heap->ids, sizeof(size_t) * size);
+    if(NULL == ids) return false;
+    heap->ids = ids;
+
+    pos = (size_t*)realloc(heap->pos, sizeof(size_t) * size);
+    if(NULL == pos) return false;
+    heap->pos = pos;
+
+    heap->handle_alloc = size;
+
+    return true;
+}
+
+static cheap_handle cheap_handle_alloc(cheap *heap)
+{
+    cheap_handle id = heap->handle_free;
+
+    if(CHEAP_HANDLE_NONE != id) {
+        heap->handle_free = heap->pos[id];
+        return id;
+    }
+
+    if(!cheap_reserve_handles(heap, heap->handle_used + 1)) {
+        return CHEAP_HANDLE_NONE;
+    }
+
+    return heap->handle_used++;
+}
+
+static void cheap_handle_release(cheap *heap, cheap_handle id)
+{
+    heap->pos[id] = heap->handle_free;
+    heap->handle_free = id;
+}
+
+/* 空闲的 handle 不会出现在 ids 中, 所以 ids[pos[h]] == h 说明 h 有效 */
+static bool cheap_handle_valid(const cheap *heap, cheap_handle id)
+{
+    return id < heap->handle_used
+        && heap->pos[id] < cvector_size64(&(heap->objs))
+        && heap->ids[heap->pos[id]] == id;
+}
+
+/*
+ * 把 i 处的元素上浮, 返回它最后的位置
+ */
+static size_t cheap_sift_up(cheap *heap, size_t i)
+{
+    void   **objs = CHEAP_OBJS(heap);
+    void   *obj   = objs[i];
+    size_t id     = heap->ids[i];
+    size_t parent = 0;
+
+    while(i > 0) {
+        parent = (i - 1) >> heap->shift;
+        if(heap->cmp(obj, objs[parent]) >= 0) break;
+
+        CHEAP_SET(heap, i, objs[parent], heap->ids[parent]);
+        i = parent;
+    }
+    CHEAP_SET(heap, i, obj, id);
+
+    return i;
+}
+
+static void cheap_sift_down(cheap *heap, size_t i)
+{
+    void   **objs = CHEAP_OBJS(heap);
+    void   *obj   = objs[i];
+    size_t id     = heap->ids[i];
+    size_t n      = cvector_size64(&(heap->objs));
+    size_t first  = 0;
+    size_t last   = 0;
+    size_t best   = 0;
+    size_t c      = 0;
+
+    if(n < 2) return;
+
+    /* i 不超过最后一个元素的父节点时才有子节点, 不会溢出 */
+    while(i <= (n - 2) >> heap->shift) {
+        first = (i << heap->shift) + 1;
+        last  = first + ((size_t)1 << heap->shift);
+        if(last > n) last = n;
+
+        best = first;
+        for(c = first + 1; c < last; ++c) {
+            if(heap->cmp(objs[c], objs[best]) < 0) best = c;
+        }
+        if(heap->cmp(objs[best], obj) >= 0) break;
+
+        CHEAP_SET(heap, i, objs[best], heap->ids[best]);
+        i = best;
+    }
+    CHEAP_SET(heap, i, obj, id);
+}
+
+static void cheap_sift(cheap *heap, size_t i)
+{
+    if(cheap_sift_up(heap, i) == i) {
+        cheap_sift_down(heap, i);
+    }
+}
+
+cheap* cheap_new_from_vector(cvector *v, cobj_cb_cmp cmp, unsigned int d)
+{
+    cheap  *heap = cheap_new_dary(cmp, d);
+    size_t n = cvector_size64(v);
+    size_t i = 0;
+
+    if(NULL == heap) return NULL;
+
+    if(!cheap_reserve_handles(heap, n) || !cvector_reserve(&(heap->objs), n)) {
+        cheap_free(heap);
+        return NULL;
+    }
+
+    cvector_extend(&(heap->objs), v);
+    for(i = 0; i < n; ++i) {
+        heap->ids[i] = heap->pos[i] = i;
+    }
+    heap->handle_used = n;
+
+    /* 从最后一个有子节点的位置开始下沉 */
+    if(n > 1) {
+        i = (n - 2) >> heap->shift;
+        do {
+            cheap_sift_down(heap, i);
+        } while(i-- > 0);
+    }
+
+    return heap;
+}
+
+cheap_handle cheap_push(cheap *heap, void *obj)
+{
+    cheap_handle id = cheap_handle_alloc(heap);
+    size_t n = cvector_size64(&(heap->objs));
+
+    if(CHEAP_HANDLE_NONE == id) return CHEAP_HANDLE_NONE;
+
+    cvector_append(&(heap->objs), obj);
+    if(cvector_size64(&(heap->objs)) == n) {
+        cheap_handle_release(heap, id);
+        return CHEAP_HANDLE_NONE;
+    }
+
+    heap->ids[n] = id;
+    cheap_sift_up(heap, n);
+
+    return id;
+}
+
+void* cheap_peek(const cheap *heap)
+{
+    return cheap_is_empty(heap) ? NULL : CHEAP_OBJS(heap)[0];
+}
+
+/*
+ * 取出 i 处的元素, 用最后一个元素填补
+ */
+static void* cheap_take_at(cheap *heap, size_t i)
+{
+    void   *obj = CHEAP_OBJS(heap)[i];
+    size_t id   = heap->ids[i];
+    size_t last = cvector_size64(&(heap->objs)) - 1;
+
+    if(i != last) {
+        CHEAP_SET(heap, i, CHEAP_OBJS(heap)[last], heap->ids[last]);
+    }
+    cvector_pop_back(&(heap->objs));
+    if(i != last) {
+        cheap_sift(heap, i);
+    }
+    cheap_handle_release(heap, id);
+
+    return obj;
+}
+
+void* cheap_pop_min(cheap *heap)
+{
+    if(cheap_is_empty(heap)) return NULL;
+
+    return cheap_take_at(heap, 0);
+}
+
+void* cheap_handle_obj(const cheap *heap, cheap_handle handle)
+{
+    if(!cheap_handle_valid(heap, handle)) return NULL;
+
+    return CHEAP_OBJS(heap)[heap->pos[handle]];
+}
+
+bool cheap_decrease_key(cheap *heap, cheap_handle handle, void *obj)
+{
+    size_t i = 0;
+    void *obj_old = NULL;
+
+    if(!cheap_handle_valid(heap, handle)) return false;
+
+    i = heap->pos[handle];
+    obj_old = CHEAP_OBJS(heap)[i];
+    if(heap->cmp(obj, obj_old) > 0) return false;
+
+    CHEAP_OBJS(heap)[i] = obj;
+    if(obj != obj_old) {
+        cobj_free(obj_old);
+    }
+    cheap_sift_up(heap, i);
+
+    return true;
+}
+
+bool cheap_update(cheap *heap, cheap_handle handle)
+{
+    if(!cheap_handle_valid(heap, handle)) return false;
+
+    cheap_sift(heap, heap->pos[handle]);
+
+    return true;
+}
+
+void* cheap_remove(cheap *heap, cheap_handle handle)
+{
+    if(!cheap_handle_valid(heap, handle)) return NULL;
+
+    return cheap_take_at(heap, heap->pos[handle]);
+}
@@ -0,0 +1,160 @@
+/* {{{
+ * =============================================================================
+ *      Filename    :   cilist.c
+ *      Description :
+ *      Created     :   2026-10-19 14:30:40
+ *      Author      :   Wu Hong
+ * =============================================================================
+ }}} */
+
+#include "cilist.h"
+
+void cilist_init(cilist *list)
+{
+    list->len  = 0;
+    list->head = NULL;
+    list->tail = NULL;
+}
+
+cilist* cilist_new(void)
+{
+    return (cilist*)calloc(1, sizeof(cilist));
+}
+
+/*
+ * Free the list only, the elements are owned by the caller.
+ */
+void cilist_free(cilist *list)
+{
+    free(list);
+}
+
+/*
+ * Unlink all elements.
+ */
+void cilist_clear(cilist *list)
+{
+    clist_link *link = list->head;
+    clist_link *next = NULL;
+
+    while(link) {
+        next = link->next;
+        link->prev = link->next = NULL;
+        link = next;
+    }
+
+    cilist_init(list);
+}
+
+bool cilist_is_empty(const cilist *list)
+{
+    return list->len == 0;
+}
+
+unsigned int cilist_len(const cilist *list)
+{
+    return list ? list->len : 0;
+}
+
+clist_link* cilist_first(const cilist *list)
+{
+    return list->head;
+}
+
+clist_link* cilist_last(const cilist *list)
+{
+    return list->tail;
+}
+
+void cilist_prepend(cilist *list, clist_link *link)
+{
+    link->prev = NULL;
+    link->next = list->head;
+
+    if(list->head) {
+        list->head->prev = link;
+    } else {
+        list->tail = link;
+    }
+    list->head = link;
+
+    ++list->len;
+}
+
+void cilist_append(cilist *list, clist_link *link)
+{
+    link->next = NULL;
+    link->prev = list->tail;
+
+    if(list->tail) {
+        list->tail->next = link;
+    } else {
+        list->head = link;
+    }
+    list->tail = link;
+
+    ++list->len;
+}
+
+/*
+ * Insert link before pos, append when pos is NULL.
+ */
+void cilist_insert_before(cilist *list, clist_link *pos, clist_link *link)
+{
+    if(NULL == pos) {
+        cilist_append(list, link);
+        return;
+    }
+
+    link->next = pos;
+    link->prev = pos->prev;
+    pos->prev ? (pos->prev->next = link) : (list->head = link);
+    pos->prev  = link;
+
+    ++list->len;
+}
+
+/*
+ * Insert link after pos, prepend when pos is NULL.
+ */
+void cilist_insert_after(cilist *list, clist_link *pos, clist_link *link)
+{
+    if(NULL == pos) {
+        cilist_prepend(list, link);
+        return;
+    }
+
+    link->prev = pos;
+    link->next = pos->next;
+    pos->next ? (pos->next->prev = link) : (list->tail = link);
+    pos->next  = link;
+
+    ++list->len;
+}
+
+void cilist_remove(cilist *list, clist_link *link)
+{
+    link->prev ? (link->prev->next = link->next) : (list->head = link->next);
+    link->next ? (link->next->prev = link->prev) : (list->tail = link->prev);
+    link->prev = link->next = NULL;
+
+    --list->len;
+}
+
+clist_link* cilist_pop_front(cilist *list)
+{
+    clist_link *link = list->head;
+
+    if(link) cilist_remove(list, link);
+
+    return link;
+}
+
+clist_link* cilist_pop_back(cilist *list)
+{
+    clist_link *link = list->tail;
+
+    if(link) cilist_remove(list, link);
+
+    return link;
+}
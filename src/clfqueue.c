@@ -0,0 +1,172 @@
+/* {{{
+ * =============================================================================
+ *      Filename    :   clfqueue.c
+ *      Description :
+ *      Created     :   2026-10-19 16:51:02
+ *      Author      :   Wu Hong
+ * =============================================================================
+ }}} */
+#include <stdint.h>
+#include "clfqueue.h"
+#include "cobj.h"
+
+#define CLFQUEUE_CACHE_LINE 64
+
+typedef struct clfqueue_cell
+{
+    size_t seq;     /* == pos 时可写入, == pos + 1 时可读取 */
+    void   *obj;
+} clfqueue_cell;
+
+struct clfqueue
+{
+    clfqueue_cell   *cells;
+    size_t          mask;
+    char            pad0[CLFQUEUE_CACHE_LINE - sizeof(void*) - sizeof(size_t)];
+
+    /* 生产者和消费者的位置放在不同的 cache line, 避免伪共享 */
+    size_t          enqueue_pos;
+    char            pad1[CLFQUEUE_CACHE_LINE - sizeof(size_t)];
+    size_t          dequeue_pos;
+    char            pad2[CLFQUEUE_CACHE_LINE - sizeof(size_t)];
+};
+
+clfqueue* clfqueue_new(unsigned int capacity)
+{
+    clfqueue *queue = NULL;
+    size_t   size   = 2;
+    size_t   i      = 0;
+
+    while(size < capacity) size <<= 1;
+
+    queue = (clfqueue*)calloc(1, sizeof(clfqueue));
+    if(NULL == queue) return NULL;
+
+    queue->cells = (clfqueue_cell*)malloc(sizeof(clfqueue_cell) * size);
+    if(NULL == queue->cells) {
+        free(queue);
+        return NULL;
+    }
+
+    queue->mask = size - 1;
+    for(i = 0; i < size; ++i) {
+        queue->cells[i].seq = i;
+        queue->cells[i].obj = NULL;
+    }
+
+    return queue;
+}
+
+void clfqueue_free(clfqueue *queue)
+{
+    void *obj = NULL;
+
+    if(queue) {
+        while((obj = clfqueue_pop_front(queue)) != NULL) {
+            cobj_free(obj);
+        }
+        free(queue->cells);
+        free(queue);
+    }
+}
+
+unsigned int clfqueue_capacity(const clfqueue *queue)
+{
+    return (unsigned int)(queue->mask + 1);
+}
+
+unsigned int clfqueue_size(const clfqueue *queue)
+{
+    size_t enqueue_pos = __atomic_load_n(&(queue->enqueue_pos), __ATOMIC_RELAXED);
+    size_t dequeue_pos = __atomic_load_n(&(queue->dequeue_pos), __ATOMIC_RELAXED);
+
+    return enqueue_pos > dequeue_pos ? (unsigned int)(enqueue_pos - dequeue_pos) : 0;
+}
+
+bool clfqueue_is_empty(const clfqueue *queue)
+{
+    return clfqueue_size(queue) == 0;
+}
+
+/*
+ * 从 *ppos 开始占用最多 max_n 个连续槽位, 返回占用的个数.
+ * 槽位的 seq 为 pos + ready 时可用 (生产者 ready 为 0, 消费者为 1).
+ */
+static unsigned int clfqueue_claim(clfqueue *queue, size_t *ppos_shared,
+                                   size_t ready, unsigned int max_n, size_t *ppos)
+{
+    size_t pos = __atomic_load_n(ppos_shared, __ATOMIC_RELAXED);
+    size_t seq = 0;
+    unsigned int n = 0;
+
+    if(max_n == 0) return 0;
+
+    for(;;) {
+        /* 统计从 pos 开始可用的槽位 */
+        for(n = 0; n < max_n; ++n) {
+            seq = __atomic_load_n(&(queue->cells[(pos + n) & queue->mask].seq),
+                                  __ATOMIC_ACQUIRE);
+            if(seq != pos + n + ready) break;
+        }
+
+        if(n == 0) {
+            /* seq 落后说明队列满 (或空), 否则 pos 已被其他线程推进 */
+            if((intptr_t)(seq - (pos + ready)) < 0) return 0;
+            pos = __atomic_load_n(ppos_shared, __ATOMIC_RELAXED);
+            continue;
+        }
+
+        if(__atomic_compare_exchange_n(ppos_shared, &pos, pos + n, true,
+                                       __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+            *ppos = pos;
+            return n;
+        }
+    }
+}
+
+unsigned int clfqueue_append_batch(clfqueue *queue, void **objs, unsigned int n)
+{
+    clfqueue_cell *cell = NULL;
+    size_t pos = 0;
+    unsigned int i = 0;
+
+    n = clfqueue_claim(queue, &(queue->enqueue_pos), 0, n, &pos);
+    for(i = 0; i < n; ++i) {
+        cell = &(queue->cells[(pos + i) & queue->mask]);
+        cell->obj = objs[i];
+        __atomic_store_n(&(cell->seq), pos + i + 1, __ATOMIC_RELEASE);
+    }
+
+    return n;
+}
+
+unsigned int clfqueue_pop_front_batch(clfqueue *queue, void **objs, unsigned int max_n)
+{
+    clfqueue_cell *cell = NULL;
+    size_t pos = 0;
+    unsigned int n = 0;
+    unsigned int i = 0;
+
+    n = clfqueue_claim(queue, &(queue->dequeue_pos), 1, max_n, &pos);
+    for(i = 0; i < n; ++i) {
+        cell = &(queue->cells[(pos + i) & queue->mask]);
+        objs[i] = cell->obj;
+        __atomic_store_n(&(cell->seq), pos + i + queue->mask + 1, __ATOMIC_RELEASE);
+    }
+
+    return n;
+}
+
+bool clfqueue_append(clfqueue *queue, void *obj)
+{
+    return clfqueue_append_batch(queue, &obj, 1) == 1;
+}
+
+void* clfqueue_pop_front(clfqueue *queue)
+{
+    void *obj = NULL;
+
+    clfqueue_pop_front_batch(queue, &obj, 1);
+
+    return obj;
+}
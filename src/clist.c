@@ -7,8 +7,100 @@
  * =============================================================================
  }}} */
 
+#include <sched.h>
+#include <string.h>
+#include <limits.h>
+#include <time.h>
 #include "clist.h"
 
+#define CLIST_POOL_SLAB_NODES   256
+
+typedef struct clist_slab {
+    struct clist_slab *next;
+    clist_node nodes[];
+}clist_slab;
+
+struct clist_pool {
+    unsigned int nodes_per_slab;
+    unsigned int slab_used;     /* 当前 slab (slabs 链表头) 已分配的节点数 */
+    clist_slab   *slabs;
+    clist_node   *nodes_free;   /* 回收的节点, 通过 next 串成链表 */
+};
+
+clist_pool* clist_pool_new(unsigned int nodes_per_slab)
+{
+    clist_pool *pool = (clist_pool*)calloc(1, sizeof(clist_pool));
+    if(NULL == pool) return NULL;
+
+    pool->nodes_per_slab = nodes_per_slab ? nodes_per_slab : CLIST_POOL_SLAB_NODES;
+
+    return pool;
+}
+
+/*
+ * 按 slab 整块释放所有节点, 不需要逐个 free
+ */
+void clist_pool_free(clist_pool *pool)
+{
+    clist_slab *slab = NULL;
+
+    if(NULL == pool) return;
+
+    while(pool->slabs) {
+        slab = pool->slabs;
+        pool->slabs = slab->next;
+        free(slab);
+    }
+    free(pool);
+}
+
+/*
+ * 所有节点都已不再使用时, 只保留当前 slab, 其余整块释放
+ */
+static void clist_pool_reset(clist_pool *pool)
+{
+    clist_slab *slab = NULL;
+
+    if(NULL == pool->slabs) return;
+
+    while(pool->slabs->next) {
+        slab = pool->slabs->next;
+        pool->slabs->next = slab->next;
+        free(slab);
+    }
+    pool->slab_used  = 0;
+    pool->nodes_free = NULL;
+}
+
+static clist_node* clist_pool_alloc(clist_pool *pool)
+{
+    clist_node *node = pool->nodes_free;
+    clist_slab *slab = NULL;
+
+    if(node) {
+        pool->nodes_free = node->next;
+        return node;
+    }
+
+    if(NULL == pool->slabs || pool->slab_used >= pool->nodes_per_slab) {
+        slab = (clist_slab*)malloc(sizeof(clist_slab)
+                                   + sizeof(clist_node) * pool->nodes_per_slab);
+        if(NULL == slab) return NULL;
+
+        slab->next  = pool->slabs;
+        pool->slabs = slab;
+        pool->slab_used = 0;
+    }
+
+    return &(pool->slabs->nodes[pool->slab_used++]);
+}
+
+static void clist_pool_release(clist_pool *pool, clist_node *node)
+{
+    node->next = pool->nodes_free;
+    pool->nodes_free = node;
+}
+
 clist_node *clist_node_new(void *val)
 {
     clist_node *self = NULL;
@@ -28,6 +120,30 @@ void clist_node_free(clist_node *node)
     free(node);
 }
 
+static clist_node* clist_node_alloc(clist *list, void *val)
+{
+    clist_node *node = NULL;
+
+    if(NULL == list->pool) return clist_node_new(val);
+
+    node = clist_pool_alloc(list->pool);
+    if(NULL == node) return NULL;
+
+    node->val = val;
+    node->next = node->prev = NULL;
+
+    return node;
+}
+
+static void clist_node_release(clist *list, clist_node *node)
+{
+    if(list->pool) {
+        clist_pool_release(list->pool, node);
+    } else {
+        free(node);
+    }
+}
+
 void* clist_iter_obj(clist_iter *iter)
 {
     return iter->node ? iter->node->val : NULL;
@@ -95,11 +211,18 @@ bool clist_iter_is_end(clist_iter *iter)
     return iter->node == NULL;
 }
 
-unsigned int  clist_len(const clist *list)
+size_t clist_len64(const clist *list)
 {
     return list ? list->len : 0;
 }
 
+unsigned int  clist_len(const clist *list)
+{
+    size_t len = clist_len64(list);
+
+    return len > UINT_MAX ? UINT_MAX : (unsigned int)len;
+}
+
 unsigned int  clist_size(const clist *list)
 {
     return clist_len(list);
@@ -112,7 +235,7 @@ unsigned int  clist_count(const clist *list)
 
 bool clist_is_empty(const clist *list)
 {
-    return clist_len(list) == 0;
+    return clist_len64(list) == 0;
 }
 
 void* clist_begin_obj(clist *list)
@@ -129,12 +252,37 @@ void* clist_last_obj(clist *list)
  * Allocate a new clist. NULL on failure.
  */
 clist* clist_new(void)
+{
+    return clist_new_with_lock(CLIST_LOCK_MUTEX);
+}
+
+clist* clist_new_with_lock(clist_lock_type lock_type)
 {
     clist *list = (clist*)calloc(1, sizeof(clist));
 
-#ifdef CLIST_ENABLE_SEM
-    list->sem = cmutex_new();
-#endif
+    list->lock_type = lock_type;
+
+    return list;
+}
+
+clist* clist_new_with_pool(clist_pool *pool)
+{
+    clist *list = clist_new();
+
+    list->pool = pool;
+
+    return list;
+}
+
+clist* clist_new_pooled(void)
+{
+    clist *list = clist_new();
+
+    if(NULL == list) return NULL;
+
+    /* pool 创建失败时退化为直接 malloc/free 节点 */
+    list->pool = clist_pool_new(0);
+    list->own_pool = (NULL != list->pool);
 
     return list;
 }
@@ -154,40 +302,140 @@ void clist_print(const clist* list)
     printf("]");
 }
 
-#ifdef CLIST_ENABLE_SEM
+static void clist_lock_release(clist *list)
+{
+    if(CLIST_LOCK_MUTEX == list->lock_type && list->lock.sem) {
+        csem_free(list->lock.sem);
+    }
+    list->lock.sem = NULL;
+}
+
+void clist_set_lock_type(clist *list, clist_lock_type lock_type)
+{
+    clist_lock_release(list);
+    list->lock_type = lock_type;
+}
+
+clist_lock_type clist_get_lock_type(const clist *list)
+{
+    return (clist_lock_type)list->lock_type;
+}
+
+/*
+ * 按需创建 mutex, 并发创建时只保留一个
+ */
+static csem* clist_lock_sem(clist *list)
+{
+    csem *sem     = __atomic_load_n(&(list->lock.sem), __ATOMIC_ACQUIRE);
+    csem *sem_new = NULL;
+
+    if(NULL == sem) {
+        sem_new = cmutex_new();
+        if(__atomic_compare_exchange_n(&(list->lock.sem), &sem, sem_new, false,
+                                       __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            sem = sem_new;
+        } else {
+            csem_free(sem_new);
+        }
+    }
+
+    return sem;
+}
+
+static inline bool clist_spin_try_lock(clist *list)
+{
+    return __atomic_exchange_n(&(list->lock.spin), 1, __ATOMIC_ACQUIRE) == 0;
+}
+
+static long clist_time_ms(void)
+{
+    struct timespec time;
+
+    clock_gettime(CLOCK_MONOTONIC, &time);
+
+    return time.tv_sec * 1000 + time.tv_nsec / 1000000;
+}
+
 void clist_lock(clist *list)
 {
-    csem_lock(list->sem);
+    switch(list->lock_type) {
+        case CLIST_LOCK_MUTEX:
+            csem_lock(clist_lock_sem(list));
+            break;
+        case CLIST_LOCK_SPIN:
+            while(!clist_spin_try_lock(list)) {
+                while(__atomic_load_n(&(list->lock.spin), __ATOMIC_RELAXED)) {
+                    sched_yield();
+                }
+            }
+            break;
+        default:
+            break;
+    }
 }
 
+/*
+ * 返回值与 csem_lock_timed 一致: 0 成功, 1 超时
+ */
 int clist_lock_timed(clist *list, int ms)
 {
-    return csem_lock_timed(list->sem, ms);
+    long time_end = 0;
+
+    switch(list->lock_type) {
+        case CLIST_LOCK_MUTEX:
+            return csem_lock_timed(clist_lock_sem(list), ms);
+        case CLIST_LOCK_SPIN:
+            time_end = clist_time_ms() + ms;
+            while(!clist_spin_try_lock(list)) {
+                if(clist_time_ms() >= time_end) return 1;
+                sched_yield();
+            }
+            return 0;
+        default:
+            return 0;
+    }
 }
 
 void clist_unlock(clist *list)
 {
-    csem_unlock(list->sem);
+    switch(list->lock_type) {
+        case CLIST_LOCK_MUTEX:
+            csem_unlock(list->lock.sem);
+            break;
+        case CLIST_LOCK_SPIN:
+            __atomic_store_n(&(list->lock.spin), 0, __ATOMIC_RELEASE);
+            break;
+        default:
+            break;
+    }
 }
-#endif
 
 void clist_clear(clist *list)
 {
-    unsigned int len = list->len;
+    size_t len = list->len;
     clist_node *next = NULL;
     clist_node *node = list->head;
 
     while (len--) {
         next = node->next;
 
-        clist_node_free(node);
+        cobj_free(node->val);
+        /* 私有 pool 在最后整体重置, 不需要逐个回收节点 */
+        if(!list->own_pool) {
+            clist_node_release(list, node);
+        }
 
         node = next;
     }
 
+    if(list->own_pool) {
+        clist_pool_reset(list->pool);
+    }
+
     list->head = NULL;
     list->tail = NULL;
     list->len  = 0;
+    list->finger = NULL;
 }
 
 /*
@@ -197,9 +445,10 @@ void clist_free(clist *list)
 {
     if(list){
         clist_clear(list);
-#ifdef CLIST_ENABLE_SEM
-        csem_free(list->sem);
-#endif
+        clist_lock_release(list);
+        if(list->own_pool) {
+            clist_pool_free(list->pool);
+        }
         free(list);
     }
 }
@@ -213,6 +462,8 @@ static void clist_push_front(clist *list, clist_node *node)
 {
     if (!node) return;
 
+    if (list->finger) ++list->finger_idx;
+
     if (list->len) {
         node->next       = list->head;
         node->prev       = NULL;
@@ -247,18 +498,66 @@ static void clist_push_back(clist *list, clist_node *node)
     ++list->len;
 }
 
+/*
+ * Insert the node before pos, append it when pos is NULL.
+ */
+static void clist_insert_node(clist *list, clist_node *pos, clist_node *node)
+{
+    if(!node) return;
+
+    if(NULL == pos) {
+        clist_push_back(list, node);
+        return;
+    }
+
+    /* 只有插入在 finger 之前且位置已知时才能保留 finger */
+    if(pos == list->finger || pos == list->head) {
+        if(list->finger) ++list->finger_idx;
+    } else {
+        list->finger = NULL;
+    }
+
+    node->next = pos;
+    node->prev = pos->prev;
+    pos->prev ? (pos->prev->next = node) : (list->head = node);
+    pos->prev  = node;
+
+    ++list->len;
+}
+
+/*
+ * Unlink the node from the list without releasing it.
+ */
+static void clist_unlink_node(clist *list, clist_node *node)
+{
+    if(list->finger == node) {
+        if(node->next) {
+            list->finger = node->next;
+        } else {
+            list->finger = node->prev;
+            --list->finger_idx;
+        }
+    } else if(list->finger && node == list->head) {
+        --list->finger_idx;
+    } else if(node != list->tail) {
+        list->finger = NULL;
+    }
+
+    node->prev ? (node->prev->next = node->next) : (list->head = node->next);
+    node->next ? (node->next->prev = node->prev) : (list->tail = node->prev);
+
+    --list->len;
+}
+
 static void* clist_detach_node(clist *list, clist_node *node)
 {
     void *obj = NULL;
 
     if(node){
-        node->prev ? (node->prev->next = node->next) : (list->head = node->next);
-        node->next ? (node->next->prev = node->prev) : (list->tail = node->prev);
-
-        --list->len;
+        clist_unlink_node(list, node);
 
         obj = node->val;
-        free(node);
+        clist_node_release(list, node);
     }
 
     return obj;
@@ -285,12 +584,12 @@ void* clist_pop(const clist_iter *iter)
 
 void clist_append(clist *list, void *obj)
 {
-    clist_push_back(list, clist_node_new(obj));
+    clist_push_back(list, clist_node_alloc(list, obj));
 }
 
 void clist_prepend(clist *list, void *obj)
 {
-    clist_push_front(list, clist_node_new(obj));
+    clist_push_front(list, clist_node_alloc(list, obj));
 }
 
 /*
@@ -368,20 +667,51 @@ bool clist_find_then_remove_with_cb(clist *list, cobj_cb_is_match cb, void *arg)
  * Return the node at the given index or NULL.
  */
 
-clist_iter clist_at(clist *list, int index)
+/*
+ * Walk from the nearest of head, tail and the finger (the node found by
+ * the last positional access), then move the finger to the result.
+ * Accessing nearby indexes one after another is O(1).
+ */
+static clist_node* clist_node_at(clist *list, size_t idx)
 {
-    clist_iter iter;
     clist_node *node = list->head;
-    int        idx   = index;
+    size_t     pos   = 0;
+    size_t     dist  = idx;
+
+    if(list->len - 1 - idx < dist) {
+        node = list->tail;
+        pos  = list->len - 1;
+        dist = list->len - 1 - idx;
+    }
+    if(list->finger) {
+        if(list->finger_idx <= idx ? idx - list->finger_idx < dist
+                                   : list->finger_idx - idx < dist) {
+            node = list->finger;
+            pos  = list->finger_idx;
+        }
+    }
+
+    while(pos < idx) { node = node->next; ++pos; }
+    while(pos > idx) { node = node->prev; --pos; }
+
+    list->finger     = node;
+    list->finger_idx = idx;
+
+    return node;
+}
+
+clist_iter clist_at64(clist *list, ssize_t index)
+{
+    clist_iter iter;
+    clist_node *node = NULL;
+    ssize_t    idx   = index;
 
     if(index < 0) {
-        idx = clist_size(list) + index;
+        idx = (ssize_t)list->len + index;
     }
 
-    if(idx >= 0 && idx < (int)list->len) {
-        while(idx) { node = node->next; --idx; }
-    } else {
-        node = NULL;
+    if(idx >= 0 && (size_t)idx < list->len) {
+        node = clist_node_at(list, idx);
     }
 
     clist_iter_init(&iter, list, node, CLIST_ITER_DIR_FORWORD);
@@ -389,12 +719,54 @@ clist_iter clist_at(clist *list, int index)
     return iter;
 }
 
-void* clist_at_obj(clist *list, int index)
+clist_iter clist_at(clist *list, int index)
+{
+    return clist_at64(list, index);
+}
+
+/*
+ * Insert obj so that it ends up at index, negative index counts from
+ * the tail (-1 appends), index is clamped to [0, len].
+ */
+void clist_insert_at64(clist *list, ssize_t index, void *obj)
 {
-    clist_iter iter = clist_at(list, index);
+    clist_node *node = clist_node_alloc(list, obj);
+    ssize_t    idx   = index;
+
+    if(!node) return;
+
+    if(index < 0) {
+        idx = (ssize_t)list->len + index + 1;
+    }
+    if(idx < 0) idx = 0;
+    if((size_t)idx > list->len) idx = list->len;
+
+    if((size_t)idx == list->len) {
+        clist_push_back(list, node);
+    } else {
+        clist_insert_node(list, clist_node_at(list, idx), node);
+    }
+
+    list->finger     = node;
+    list->finger_idx = idx;
+}
+
+void clist_insert_at(clist *list, int index, void *obj)
+{
+    clist_insert_at64(list, index, obj);
+}
+
+void* clist_at_obj64(clist *list, ssize_t index)
+{
+    clist_iter iter = clist_at64(list, index);
     return clist_iter_obj(&iter);
 }
 
+void* clist_at_obj(clist *list, int index)
+{
+    return clist_at_obj64(list, index);
+}
+
 /*
  * Remove the given node from the list, freeing it and it's value.
  */
@@ -411,13 +783,18 @@ void clist_remove(clist_iter *iter)
     cobj_free(obj);
 }
 
-void clist_remove_at(clist *list, int index)
+void clist_remove_at64(clist *list, ssize_t index)
 {
-    clist_iter iter = clist_at(list, index);
+    clist_iter iter = clist_at64(list, index);
 
     clist_remove(&iter);
 }
 
+void clist_remove_at(clist *list, int index)
+{
+    clist_remove_at64(list, index);
+}
+
 void clist_remove_first(clist *list)
 {
     clist_remove_at(list, 0);
@@ -427,3 +804,321 @@ void clist_remove_last(clist *list)
 {
     clist_remove_at(list, -1);
 }
+
+/* ==========================================================================
+ *        sort
+ * ========================================================================== */
+
+/*
+ * Merge two next-linked chains, on equal values a goes first (stable).
+ */
+static clist_node* clist_merge_chain(clist_node *a, clist_node *b,
+                                     cobj_cb_cmp cmp, int order)
+{
+    clist_node  head;
+    clist_node  *tail = &head;
+    int         ret   = 0;
+
+    while(a && b) {
+        ret = cmp(a->val, b->val);
+        if(order > 0 ? ret <= 0 : ret >= 0) {
+            tail->next = a;
+            a = a->next;
+        } else {
+            tail->next = b;
+            b = b->next;
+        }
+        tail = tail->next;
+    }
+    tail->next = a ? a : b;
+
+    return head.next;
+}
+
+/*
+ * Cut the leading run (already in order, or strictly reversed) off
+ * the chain, reversing it when needed. *rest receives the remainder.
+ */
+static clist_node* clist_cut_run(clist_node *node, clist_node **rest,
+                                 cobj_cb_cmp cmp, int order)
+{
+    clist_node *run  = node;
+    clist_node *next = NULL;
+    clist_node *prev = NULL;
+    int ret = 0;
+
+    if(NULL == node->next) {
+        *rest = NULL;
+        return run;
+    }
+
+    ret = cmp(node->val, node->next->val);
+    if(order > 0 ? ret <= 0 : ret >= 0) {
+        do {
+            node = node->next;
+            ret  = node->next ? cmp(node->val, node->next->val) : 0;
+        } while(node->next && (order > 0 ? ret <= 0 : ret >= 0));
+
+        *rest = node->next;
+        node->next = NULL;
+        return run;
+    }
+
+    /* strictly reversed run, reverse it in place */
+    do {
+        next = node->next;
+        node->next = prev;
+        prev = node;
+        node = next;
+        ret  = node->next ? cmp(node->val, node->next->val) : 0;
+    } while(node->next && (order > 0 ? ret > 0 : ret < 0));
+
+    *rest = node->next;
+    node->next = prev;
+
+    return node;
+}
+
+/*
+ * Rebuild prev pointers and tail after the chain was relinked.
+ */
+static void clist_relink(clist *list, clist_node *head)
+{
+    clist_node *prev = NULL;
+    clist_node *node = head;
+
+    list->head   = head;
+    list->finger = NULL;
+    for(; node; node = node->next) {
+        node->prev = prev;
+        prev = node;
+    }
+    list->tail = prev;
+}
+
+/*
+ * Natural bottom-up merge sort. Runs are merged like a binary counter,
+ * bins[i] always holds elements earlier than bins[i - 1], no allocation.
+ */
+static void clist_sort_order(clist *list, cobj_cb_cmp cmp, int order)
+{
+    clist_node *bins[64] = { NULL };
+    clist_node *rest  = list->head;
+    clist_node *carry = NULL;
+    int i = 0;
+    int max_bin = 0;
+
+    if(list->len < 2) return;
+    if(NULL == cmp) cmp = cobj_cmp;
+
+    while(rest) {
+        carry = clist_cut_run(rest, &rest, cmp, order);
+
+        for(i = 0; i < 63 && bins[i]; ++i) {
+            carry = clist_merge_chain(bins[i], carry, cmp, order);
+            bins[i] = NULL;
+        }
+        bins[i] = i < 63 ? carry : clist_merge_chain(bins[i], carry, cmp, order);
+        if(i > max_bin) max_bin = i;
+    }
+
+    carry = NULL;
+    for(i = 0; i <= max_bin; ++i) {
+        if(bins[i]) {
+            carry = carry ? clist_merge_chain(bins[i], carry, cmp, order) : bins[i];
+        }
+    }
+
+    clist_relink(list, carry);
+}
+
+void clist_sort_asc(clist *list)
+{
+    clist_sort_order(list, NULL, 1);
+}
+
+void clist_sort_desc(clist *list)
+{
+    clist_sort_order(list, NULL, -1);
+}
+
+void clist_sort_with_cb(clist *list, cobj_cb_cmp cmp)
+{
+    clist_sort_order(list, cmp, 1);
+}
+
+/*
+ * Nodes from a list with another allocator are reallocated in dst
+ * first, so they are always released to the allocator they came from.
+ */
+static clist_node* clist_take_chain(clist *dst, clist *src)
+{
+    clist_node *head = src->head;
+    clist tmp;
+
+    if(dst->pool != src->pool) {
+        memset(&tmp, 0, sizeof(tmp));
+        tmp.pool = dst->pool;
+        while(!clist_is_empty(src)) {
+            clist_push_back(&tmp, clist_node_alloc(dst, clist_pop_front(src)));
+        }
+        head = tmp.head;
+    }
+
+    src->head = src->tail = NULL;
+    src->len  = 0;
+    src->finger = NULL;
+
+    return head;
+}
+
+void clist_merge(clist *dst, clist *src, cobj_cb_cmp cmp)
+{
+    size_t len = dst->len + src->len;
+
+    if(dst == src || clist_is_empty(src)) return;
+    if(NULL == cmp) cmp = cobj_cmp;
+
+    clist_relink(dst, clist_merge_chain(dst->head, clist_take_chain(dst, src), cmp, 1));
+    dst->len = len;
+}
+
+/*
+ * Move the n nodes [first, last] from src to before pos in dst (append when
+ * pos is NULL). Only relinks when both lists share the allocator.
+ */
+static void clist_splice_nodes(clist *dst, clist_node *pos, clist *src,
+                               clist_node *first, clist_node *last, size_t n)
+{
+    clist_node *stop = last->next;
+    clist_node *next = NULL;
+    clist_node *node = NULL;
+    clist tmp;
+
+    first->prev ? (first->prev->next = stop) : (src->head = stop);
+    stop ? (stop->prev = first->prev) : (src->tail = first->prev);
+    src->len   -= n;
+    src->finger = NULL;
+    first->prev = last->next = NULL;
+
+    if(dst->pool != src->pool) {
+        memset(&tmp, 0, sizeof(tmp));
+        tmp.pool = dst->pool;
+        for(node = first; node; node = next) {
+            next = node->next;
+            clist_push_back(&tmp, clist_node_alloc(dst, node->val));
+            clist_node_release(src, node);
+        }
+        first = tmp.head;
+        last  = tmp.tail;
+    }
+
+    last->next  = pos;
+    first->prev = pos ? pos->prev : dst->tail;
+    first->prev ? (first->prev->next = first) : (dst->head = first);
+    pos ? (pos->prev = last) : (dst->tail = last);
+    dst->len   += n;
+    dst->finger = NULL;
+}
+
+void clist_splice(clist *dst, const clist_iter *pos, clist *src,
+                  const clist_iter *first, const clist_iter *last)
+{
+    clist_node *stop = last ? last->node : NULL;
+    clist_node *tail = NULL;
+    clist_node *node = NULL;
+    size_t     n     = 0;
+
+    if(NULL == first->node || first->node == stop) return;
+
+    if(first->node == src->head && NULL == stop) {
+        n    = src->len;
+        tail = src->tail;
+    } else {
+        for(node = first->node; node != stop; node = node->next) {
+            tail = node;
+            ++n;
+        }
+    }
+
+    clist_splice_nodes(dst, pos ? pos->node : NULL, src, first->node, tail, n);
+}
+
+void clist_concat(clist *dst, clist *src)
+{
+    if(dst == src || clist_is_empty(src)) return;
+
+    clist_splice_nodes(dst, NULL, src, src->head, src->tail, src->len);
+}
+
+clist* clist_split_at(clist *list, const clist_iter *iter)
+{
+    clist *rest = NULL;
+    clist_node *fwd  = iter->node;
+    clist_node *back = iter->node;
+    size_t     n     = 0;
+
+    if(list->own_pool) {
+        rest = clist_new_pooled();
+    } else {
+        rest = clist_new_with_pool(list->pool);
+    }
+    if(NULL == rest) return NULL;
+    rest->lock_type = list->lock_type;
+
+    if(NULL == iter->node) return rest;
+
+    /* 从 iter 向两端同时走, 先到头的一端决定 rest 的长度 */
+    for(;;) {
+        if(NULL == fwd) break;
+        fwd = fwd->next;
+        ++n;
+        back = back->prev;
+        if(NULL == back) {
+            n = list->len - n + 1;
+            break;
+        }
+    }
+
+    clist_splice_nodes(rest, NULL, list, iter->node, list->tail, n);
+
+    return rest;
+}
+
+void clist_move64(clist *list, ssize_t from, ssize_t to)
+{
+    clist_iter iter_from = clist_at64(list, from);
+    clist_iter iter_to;
+    clist_node *node = iter_from.node;
+
+    if(NULL == node) return;
+    if(to < 0) to += (ssize_t)list->len;
+    if(to < 0 || (size_t)to >= list->len) return;
+
+    clist_unlink_node(list, node);
+    iter_to = clist_at64(list, to);
+    clist_insert_node(list, iter_to.node, node);
+}
+
+void clist_move(clist *list, int from, int to)
+{
+    clist_move64(list, from, to);
+}
+
+void clist_swap64(clist *list, ssize_t i, ssize_t j)
+{
+    clist_iter iter_i = clist_at64(list, i);
+    clist_iter iter_j = clist_at64(list, j);
+    void *val = NULL;
+
+    if(NULL == iter_i.node || NULL == iter_j.node) return;
+
+    val = iter_i.node->val;
+    iter_i.node->val = iter_j.node->val;
+    iter_j.node->val = val;
+}
+
+void clist_swap(clist *list, int i, int j)
+{
+    clist_swap64(list, i, j);
+}
@@ -83,7 +83,17 @@ int  csem_lock(csem *sem)
 #endif
 }
 
-/* void csem_acquire(csem *sem, int n); */
+int  csem_acquire(csem *sem, int n)
+{
+    int ret = 0;
+
+    while(n-- > 0 && ret == 0) {
+        ret = csem_lock(sem);
+    }
+
+    return ret;
+}
+
 void csem_unlock(csem *sem)
 {
 #ifdef WIN32
@@ -169,8 +179,33 @@ bool csem_try_lock(csem *sem)
 #endif
 }
 
-/* bool csem_try_acquire(csem *sem, int n); */
-/* void csem_release(csem *sem, int n); */
+/* 要么获取全部 n 个资源, 要么一个都不获取 */
+bool csem_try_acquire(csem *sem, int n)
+{
+    int i = 0;
+
+    for(i = 0; i < n; ++i) {
+        if(!csem_try_lock(sem)) {
+            csem_release(sem, i);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void csem_release(csem *sem, int n)
+{
+    if(n <= 0) return;
+
+#ifdef WIN32
+    ReleaseSemaphore(sem->sem, n, NULL);
+#else
+    while(n-- > 0) {
+        sem_post(&(sem->sem));
+    }
+#endif
+}
 
 /**
  * @Brief  Returns the number of resources currently available to the semaphore.
@@ -0,0 +1,191 @@
+/* {{{
+ * =============================================================================
+ *      Filename    :   cset.c
+ *      Description :
+ *      Created     :   2026-10-19 18:31:17
+ *      Author      :   Wu Hong
+ * =============================================================================
+ }}} */
+#include "cset.h"
+#include "chash_tpl.h"
+
+CHASH_DECLARE(cset_index, const void*, clist_node*, cobj_hash, cobj_equal)
+
+struct cset
+{
+    clist       *list;
+    cset_index  index;      /* obj -> clist_node */
+};
+
+cset* cset_new(void)
+{
+    cset *set = (cset*)calloc(1, sizeof(cset));
+
+    if(NULL == set) return NULL;
+
+    set->list = clist_new_with_lock(CLIST_LOCK_NONE);
+    if(NULL == set->list) {
+        free(set);
+        return NULL;
+    }
+
+    return set;
+}
+
+void cset_free(cset *set)
+{
+    if(set) {
+        clist_free(set->list);
+        cset_index_release(&(set->index));
+        free(set);
+    }
+}
+
+void cset_clear(cset *set)
+{
+    clist_clear(set->list);
+    cset_index_clear(&(set->index));
+}
+
+void cset_print(const cset *set)
+{
+    clist_print(set->list);
+}
+
+bool cset_is_empty(const cset *set)
+{
+    return clist_is_empty(set->list);
+}
+
+unsigned int cset_len(const cset *set)
+{
+    return clist_len(set->list);
+}
+
+static bool cset_add(cset *set, void *obj, bool at_front)
+{
+    clist_node **pnode = NULL;
+    bool is_new = false;
+    size_t len = clist_len64(set->list);
+
+    pnode = cset_index_put(&(set->index), obj, &is_new);
+    if(NULL == pnode || !is_new) return false;
+
+    if(at_front) {
+        clist_prepend(set->list, obj);
+    } else {
+        clist_append(set->list, obj);
+    }
+
+    /* 节点分配失败时删除刚放入 index 的位置 */
+    if(clist_len64(set->list) == len) {
+        cset_index_del(&(set->index), obj);
+        return false;
+    }
+    *pnode = at_front ? set->list->head : set->list->tail;
+
+    return true;
+}
+
+bool cset_append(cset *set, void *obj)
+{
+    return cset_add(set, obj, false);
+}
+
+bool cset_prepend(cset *set, void *obj)
+{
+    return cset_add(set, obj, true);
+}
+
+static clist_node* cset_find_node(const cset *set, const void *obj)
+{
+    clist_node **pnode = cset_index_get(&(set->index), obj);
+
+    return pnode ? *pnode : NULL;
+}
+
+bool cset_contains(const cset *set, const void *obj)
+{
+    return cset_index_haskey(&(set->index), obj);
+}
+
+clist_iter cset_find(cset *set, const void *obj)
+{
+    clist_iter iter = clist_begin(set->list);
+
+    iter.node = cset_find_node(set, obj);
+
+    return iter;
+}
+
+void* cset_find_obj(const cset *set, const void *obj)
+{
+    clist_node *node = cset_find_node(set, obj);
+
+    return node ? node->val : NULL;
+}
+
+/* 从 list 中移出 node 并返回其元素 */
+static void* cset_unlink(cset *set, clist_node *node)
+{
+    clist_iter iter = clist_begin(set->list);
+    void *obj = node->val;
+
+    cset_index_del(&(set->index), obj);
+
+    iter.node = node;
+    return clist_pop(&iter);
+}
+
+void* cset_take(cset *set, const void *obj)
+{
+    clist_node *node = cset_find_node(set, obj);
+
+    return node ? cset_unlink(set, node) : NULL;
+}
+
+bool cset_remove(cset *set, const void *obj)
+{
+    clist_node *node = cset_find_node(set, obj);
+
+    if(NULL == node) return false;
+
+    cobj_free(cset_unlink(set, node));
+
+    return true;
+}
+
+void* cset_pop_front(cset *set)
+{
+    return cset_is_empty(set) ? NULL : cset_unlink(set, set->list->head);
+}
+
+void* cset_pop_back(cset *set)
+{
+    return cset_is_empty(set) ? NULL : cset_unlink(set, set->list->tail);
+}
+
+clist_iter cset_begin(cset *set)
+{
+    return clist_begin(set->list);
+}
+
+clist_iter cset_rbegin(cset *set)
+{
+    return clist_rbegin(set->list);
+}
+
+clist_iter cset_end(cset *set)
+{
+    return clist_end(set->list);
+}
+
+void* cset_begin_obj(cset *set)
+{
+    return clist_begin_obj(set->list);
+}
+
+void* cset_last_obj(cset *set)
+{
+    return clist_last_obj(set->list);
+}
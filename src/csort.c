@@ -0,0 +1,780 @@
+/* {{{
+ * =============================================================================
+ *      Filename    :   csort.c
+ *      Description :
+ *      Created     :   2026-10-19 20:51:33
+ *      Author      :   Wu Hong
+ * =============================================================================
+ }}} */
+#include <string.h>
+#include <pthread.h>
+#include "csort.h"
+#include "cobj_int.h"
+#include "cobj_str.h"
+
+#define CSORT_INSERTION_MAX     24      /* 小于此长度使用插入排序 */
+#define CSORT_NINTHER_MIN       128     /* 大于此长度使用 9 个数取中 */
+#define CSORT_PARTIAL_MOVES     8       /* 部分插入排序最多移动的次数 */
+#define CSORT_STABLE_RUN        32
+#define CSORT_RADIX_STR_MIN     32      /* 小于此长度的字符串桶使用插入排序 */
+
+#define CSORT_SWAP(a, b) do { void *tmp_ = (a); (a) = (b); (b) = tmp_; } while(0)
+
+static void csort_insertion(void **a, size_t n, cobj_cb_cmp cmp)
+{
+    size_t i = 0;
+    size_t j = 0;
+    void *x = NULL;
+
+    for(i = 1; i < n; ++i) {
+        x = a[i];
+        for(j = i; j > 0 && cmp(x, a[j - 1]) < 0; --j) {
+            a[j] = a[j - 1];
+        }
+        a[j] = x;
+    }
+}
+
+/* a[-1] 不大于区间内的所有元素, 可以省去下标检查 */
+static void csort_unguarded_insertion(void **a, size_t n, cobj_cb_cmp cmp)
+{
+    size_t i = 0;
+    void **p = NULL;
+    void *x = NULL;
+
+    for(i = 1; i < n; ++i) {
+        x = a[i];
+        for(p = a + i; cmp(x, p[-1]) < 0; --p) {
+            p[0] = p[-1];
+        }
+        *p = x;
+    }
+}
+
+/*
+ * 移动次数超过 CSORT_PARTIAL_MOVES 时放弃, 返回是否已排好序
+ */
+static bool csort_partial_insertion(void **a, size_t n, cobj_cb_cmp cmp)
+{
+    size_t moves = 0;
+    size_t i = 0;
+    size_t j = 0;
+    void *x = NULL;
+
+    for(i = 1; i < n; ++i) {
+        x = a[i];
+        for(j = i; j > 0 && cmp(x, a[j - 1]) < 0; --j) {
+            a[j] = a[j - 1];
+        }
+        a[j] = x;
+
+        moves += i - j;
+        if(moves > CSORT_PARTIAL_MOVES) return false;
+    }
+
+    return true;
+}
+
+static void csort_sift_down(void **a, size_t n, size_t i, cobj_cb_cmp cmp)
+{
+    void *x = a[i];
+    size_t child = 0;
+
+    while((child = 2 * i + 1) < n) {
+        if(child + 1 < n && cmp(a[child], a[child + 1]) < 0) ++child;
+        if(!(cmp(x, a[child]) < 0)) break;
+        a[i] = a[child];
+        i = child;
+    }
+    a[i] = x;
+}
+
+static void csort_heapsort(void **a, size_t n, cobj_cb_cmp cmp)
+{
+    size_t i = n / 2;
+
+    while(i-- > 0) {
+        csort_sift_down(a, n, i, cmp);
+    }
+    while(n-- > 1) {
+        CSORT_SWAP(a[0], a[n]);
+        csort_sift_down(a, n, 0, cmp);
+    }
+}
+
+static void csort_sort2(void **a, void **b, cobj_cb_cmp cmp)
+{
+    if(cmp(*b, *a) < 0) CSORT_SWAP(*a, *b);
+}
+
+static void csort_sort3(void **a, void **b, void **c, cobj_cb_cmp cmp)
+{
+    csort_sort2(a, b, cmp);
+    csort_sort2(b, c, cmp);
+    csort_sort2(a, b, cmp);
+}
+
+/*
+ * 以 a[0] 为 pivot 划分, 与 pivot 相等的元素放在右边, 返回 pivot 的位置.
+ * 调用前保证区间内存在 >= pivot 的元素.
+ */
+static size_t csort_partition_right(void **a, size_t n, cobj_cb_cmp cmp, bool *partitioned)
+{
+    void *pivot = a[0];
+    size_t first = 0;
+    size_t last  = n;
+
+    while(cmp(a[++first], pivot) < 0);
+    if(first == 1) {
+        while(first < last && !(cmp(a[--last], pivot) < 0));
+    } else {
+        while(!(cmp(a[--last], pivot) < 0));
+    }
+
+    *partitioned = first >= last;
+    while(first < last) {
+        CSORT_SWAP(a[first], a[last]);
+        while(cmp(a[++first], pivot) < 0);
+        while(!(cmp(a[--last], pivot) < 0));
+    }
+
+    a[0] = a[first - 1];
+    a[first - 1] = pivot;
+
+    return first - 1;
+}
+
+/*
+ * 与 pivot 相等的元素放在左边, 用于 pivot 与前一个区间的元素相等时,
+ * 这些元素不需要再排序.
+ */
+static size_t csort_partition_left(void **a, size_t n, cobj_cb_cmp cmp)
+{
+    void *pivot = a[0];
+    size_t first = 0;
+    size_t last  = n;
+
+    while(cmp(pivot, a[--last]) < 0);
+    if(last + 1 == n) {
+        while(first < last && !(cmp(pivot, a[++first]) < 0));
+    } else {
+        while(!(cmp(pivot, a[++first]) < 0));
+    }
+
+    while(first < last) {
+        CSORT_SWAP(a[first], a[last]);
+        while(cmp(pivot, a[--last]) < 0);
+        while(!(cmp(pivot, a[++first]) < 0));
+    }
+
+    a[0] = a[last];
+    a[last] = pivot;
+
+    return last;
+}
+
+static void csort_pdq(void **a, size_t n, cobj_cb_cmp cmp, int bad_allowed, bool leftmost)
+{
+    size_t half = 0;
+    size_t pivot = 0;
+    size_t l_size = 0;
+    size_t r_size = 0;
+    bool partitioned = false;
+
+    for(;;) {
+        if(n < CSORT_INSERTION_MAX) {
+            if(leftmost) {
+                csort_insertion(a, n, cmp);
+            } else {
+                csort_unguarded_insertion(a, n, cmp);
+            }
+            return;
+        }
+
+        half = n / 2;
+        if(n > CSORT_NINTHER_MIN) {
+            csort_sort3(a, a + half, a + n - 1, cmp);
+            csort_sort3(a + 1, a + half - 1, a + n - 2, cmp);
+            csort_sort3(a + 2, a + half + 1, a + n - 3, cmp);
+            csort_sort3(a + half - 1, a + half, a + half + 1, cmp);
+            CSORT_SWAP(a[0], a[half]);
+        } else {
+            csort_sort3(a + half, a, a + n - 1, cmp);
+        }
+
+        /* pivot 等于左边的元素, 说明区间中有大量相等的元素 */
+        if(!leftmost && !(cmp(a[-1], a[0]) < 0)) {
+            pivot = csort_partition_left(a, n, cmp);
+            a += pivot + 1;
+            n -= pivot + 1;
+            continue;
+        }
+
+        pivot  = csort_partition_right(a, n, cmp, &partitioned);
+        l_size = pivot;
+        r_size = n - pivot - 1;
+
+        if(l_size < n / 8 || r_size < n / 8) {
+            if(--bad_allowed == 0) {
+                csort_heapsort(a, n, cmp);
+                return;
+            }
+
+            /* 打乱两边的元素, 破坏导致划分不均匀的模式 */
+            if(l_size >= CSORT_INSERTION_MAX) {
+                CSORT_SWAP(a[0], a[l_size / 4]);
+                CSORT_SWAP(a[pivot - 1], a[pivot - l_size / 4]);
+                if(l_size > CSORT_NINTHER_MIN) {
+                    CSORT_SWAP(a[1], a[l_size / 4 + 1]);
+                    CSORT_SWAP(a[2], a[l_size / 4 + 2]);
+                    CSORT_SWAP(a[pivot - 2], a[pivot - (l_size / 4 + 1)]);
+                    CSORT_SWAP(a[pivot - 3], a[pivot - (l_size / 4 + 2)]);
+                }
+            }
+            if(r_size >= CSORT_INSERTION_MAX) {
+                CSORT_SWAP(a[pivot + 1], a[pivot + 1 + r_size / 4]);
+                CSORT_SWAP(a[n - 1], a[n - r_size / 4]);
+                if(r_size > CSORT_NINTHER_MIN) {
+                    CSORT_SWAP(a[pivot + 2], a[pivot + 2 + r_size / 4]);
+                    CSORT_SWAP(a[pivot + 3], a[pivot + 3 + r_size / 4]);
+                    CSORT_SWAP(a[n - 2], a[n - (1 + r_size / 4)]);
+                    CSORT_SWAP(a[n - 3], a[n - (2 + r_size / 4)]);
+                }
+            }
+        } else if(partitioned
+                  && csort_partial_insertion(a, l_size, cmp)
+                  && csort_partial_insertion(a + pivot + 1, r_size, cmp)) {
+            /* 没有发生交换, 两边也几乎有序 */
+            return;
+        }
+
+        csort_pdq(a, l_size, cmp, bad_allowed, leftmost);
+        a += pivot + 1;
+        n  = r_size;
+        leftmost = false;
+    }
+}
+
+void csort_sort(void **objs, size_t n, cobj_cb_cmp cmp)
+{
+    int bad_allowed = 1;
+    size_t m = n;
+
+    if(n < 2) return;
+    if(NULL == cmp) cmp = cobj_cmp;
+
+    while(m >>= 1) ++bad_allowed;
+
+    csort_pdq(objs, n, cmp, bad_allowed, true);
+}
+
+/*
+ * 把有序的 src[0, mid) 和 src[mid, n) 归并到 dst, 相等时左边优先
+ */
+static void csort_merge(void **src, size_t mid, size_t n, void **dst, cobj_cb_cmp cmp)
+{
+    size_t i = 0;
+    size_t j = mid;
+    size_t k = 0;
+
+    if(mid == 0 || mid == n || !(cmp(src[mid], src[mid - 1]) < 0)) {
+        memcpy(dst, src, sizeof(void*) * n);
+        return;
+    }
+
+    while(i < mid && j < n) {
+        dst[k++] = cmp(src[j], src[i]) < 0 ? src[j++] : src[i++];
+    }
+    memcpy(dst + k, src + i, sizeof(void*) * (mid - i));
+    k += mid - i;
+    memcpy(dst + k, src + j, sizeof(void*) * (n - j));
+}
+
+void csort_stable_sort(void **objs, size_t n, cobj_cb_cmp cmp)
+{
+    void **buf = NULL;
+    void **src = objs;
+    void **dst = NULL;
+    void **tmp = NULL;
+    size_t width = 0;
+    size_t i = 0;
+
+    if(n < 2) return;
+    if(NULL == cmp) cmp = cobj_cmp;
+
+    if(n <= CSORT_STABLE_RUN || NULL == (buf = (void**)malloc(sizeof(void*) * n))) {
+        csort_insertion(objs, n, cmp);
+        return;
+    }
+
+    for(i = 0; i < n; i += CSORT_STABLE_RUN) {
+        csort_insertion(objs + i, n - i < CSORT_STABLE_RUN ? n - i : CSORT_STABLE_RUN, cmp);
+    }
+
+    dst = buf;
+    for(width = CSORT_STABLE_RUN; width < n; width *= 2) {
+        for(i = 0; i < n; i += 2 * width) {
+            if(n - i <= width) {
+                memcpy(dst + i, src + i, sizeof(void*) * (n - i));
+            } else {
+                csort_merge(src + i, width, n - i < 2 * width ? n - i : 2 * width, dst + i, cmp);
+            }
+        }
+        tmp = src; src = dst; dst = tmp;
+    }
+
+    if(src != objs) {
+        memcpy(objs, src, sizeof(void*) * n);
+    }
+    free(buf);
+}
+
+typedef struct csort_task
+{
+    void        **src;
+    void        **dst;
+    size_t      mid;
+    size_t      n;
+    cobj_cb_cmp cmp;
+} csort_task;
+
+/* dst 为 NULL 时排序 src, 否则把 src 的两段归并到 dst */
+static void* csort_worker(void *arg)
+{
+    csort_task *task = (csort_task*)arg;
+
+    if(NULL == task->dst) {
+        csort_sort(task->src, task->n, task->cmp);
+    } else {
+        csort_merge(task->src, task->mid, task->n, task->dst, task->cmp);
+    }
+
+    return NULL;
+}
+
+/*
+ * 第一个任务在当前线程执行, 线程创建失败时也在当前线程执行
+ */
+static void csort_run_parallel(csort_task *tasks, int ntasks)
+{
+    pthread_t *tids = (pthread_t*)malloc(sizeof(pthread_t) * ntasks);
+    bool *started = (bool*)calloc(ntasks, sizeof(bool));
+    int i = 0;
+
+    if(tids && started) {
+        for(i = 1; i < ntasks; ++i) {
+            started[i] = 0 == pthread_create(&tids[i], NULL, csort_worker, &tasks[i]);
+        }
+    }
+    csort_worker(&tasks[0]);
+    for(i = 1; i < ntasks; ++i) {
+        if(started && started[i]) {
+            pthread_join(tids[i], NULL);
+        } else {
+            csort_worker(&tasks[i]);
+        }
+    }
+
+    free(tids);
+    free(started);
+}
+
+void csort_sort_parallel(void **objs, size_t n, cobj_cb_cmp cmp, int nthreads)
+{
+    csort_task *tasks = NULL;
+    size_t *bounds = NULL;
+    void **buf = NULL;
+    void **src = objs;
+    void **dst = NULL;
+    void **tmp = NULL;
+    int parts = 0;
+    int ntasks = 0;
+    int i = 0;
+
+    if(NULL == cmp) cmp = cobj_cmp;
+    if(nthreads > (int)(n / CSORT_NINTHER_MIN)) nthreads = (int)(n / CSORT_NINTHER_MIN);
+    if(nthreads <= 1) {
+        csort_sort(objs, n, cmp);
+        return;
+    }
+
+    buf    = (void**)malloc(sizeof(void*) * n);
+    tasks  = (csort_task*)malloc(sizeof(csort_task) * nthreads);
+    bounds = (size_t*)malloc(sizeof(size_t) * (nthreads + 1));
+    if(NULL == buf || NULL == tasks || NULL == bounds) {
+        csort_sort(objs, n, cmp);
+        goto out;
+    }
+
+    for(i = 0; i <= nthreads; ++i) {
+        bounds[i] = n / nthreads * i + ((size_t)i < n % nthreads ? (size_t)i : n % nthreads);
+    }
+    for(i = 0; i < nthreads; ++i) {
+        tasks[i].src = objs + bounds[i];
+        tasks[i].dst = NULL;
+        tasks[i].n   = bounds[i + 1] - bounds[i];
+        tasks[i].cmp = cmp;
+    }
+    csort_run_parallel(tasks, nthreads);
+
+    /* 每一轮把相邻的两段归并, 段数减半 */
+    dst = buf;
+    for(parts = nthreads; parts > 1; parts = (parts + 1) / 2) {
+        for(ntasks = 0, i = 0; i < parts; i += 2) {
+            tasks[ntasks].src = src + bounds[i];
+            tasks[ntasks].dst = dst + bounds[i];
+            tasks[ntasks].cmp = cmp;
+            tasks[ntasks].mid = bounds[i + 1] - bounds[i];
+            tasks[ntasks].n   = bounds[i + 2 <= parts ? i + 2 : i + 1] - bounds[i];
+            bounds[ntasks] = bounds[i];
+            ++ntasks;
+        }
+        bounds[ntasks] = n;
+        csort_run_parallel(tasks, ntasks);
+        tmp = src; src = dst; dst = tmp;
+    }
+
+    if(src != objs) {
+        memcpy(objs, src, sizeof(void*) * n);
+    }
+
+out:
+    free(buf);
+    free(tasks);
+    free(bounds);
+}
+
+size_t csort_lower_bound(void *const *objs, size_t n, const void *key, cobj_cb_cmp cmp)
+{
+    size_t first = 0;
+    size_t half = 0;
+
+    if(NULL == cmp) cmp = cobj_cmp;
+
+    while(n > 0) {
+        half = n / 2;
+        if(cmp(objs[first + half], key) < 0) {
+            first += half + 1;
+            n -= half + 1;
+        } else {
+            n = half;
+        }
+    }
+
+    return first;
+}
+
+size_t csort_upper_bound(void *const *objs, size_t n, const void *key, cobj_cb_cmp cmp)
+{
+    size_t first = 0;
+    size_t half = 0;
+
+    if(NULL == cmp) cmp = cobj_cmp;
+
+    while(n > 0) {
+        half = n / 2;
+        if(!(cmp(key, objs[first + half]) < 0)) {
+            first += half + 1;
+            n -= half + 1;
+        } else {
+            n = half;
+        }
+    }
+
+    return first;
+}
+
+/* ==========================================================================
+ *        radix sort
+ * ========================================================================== */
+typedef struct csort_radix_part
+{
+    size_t first;
+    size_t n;
+    size_t depth;
+} csort_radix_part;
+
+struct csort_radix
+{
+    void        *buf;           /* 排序时的临时数组 */
+    size_t      buf_size;       /* 字节 */
+    csort_radix_part *parts;    /* MSD 待处理的区间 */
+    size_t      parts_alloc;
+};
+
+uint64_t csort_key_cobj_int(const void *obj)
+{
+    return (uint32_t)cobj_int_val((cobj_int*)obj) ^ 0x80000000u;
+}
+
+const char* csort_str_cobj_str(const void *obj)
+{
+    return ((const cobj_str*)obj)->val;
+}
+
+csort_radix* csort_radix_new(void)
+{
+    return (csort_radix*)calloc(1, sizeof(csort_radix));
+}
+
+void csort_radix_free(csort_radix *ctx)
+{
+    if(ctx) {
+        free(ctx->buf);
+        free(ctx->parts);
+        free(ctx);
+    }
+}
+
+static void* csort_radix_buf(csort_radix *ctx, size_t size)
+{
+    void *buf = NULL;
+
+    if(size <= ctx->buf_size) return ctx->buf;
+
+    buf = malloc(size);
+    if(NULL == buf) return NULL;
+
+    free(ctx->buf);
+    ctx->buf = buf;
+    ctx->buf_size = size;
+
+    return buf;
+}
+
+/*
+ * 按 keys 的每个字节做计数排序, objs 为 NULL 时只排序 keys.
+ * keys2 / objs2 为同样大小的临时空间.
+ */
+static void csort_radix_lsd(uint64_t *keys, void **objs, size_t n,
+                            uint64_t *keys2, void **objs2)
+{
+    size_t counts[8][256];
+    size_t sum = 0;
+    size_t tmp = 0;
+    size_t i = 0;
+    size_t pos = 0;
+    uint64_t *ktmp = NULL;
+    void **otmp = NULL;
+    uint64_t *keys_in = keys;
+    void **objs_in = objs;
+    int shift = 0;
+    int b = 0;
+
+    memset(counts, 0, sizeof(counts));
+
+    /* 一次遍历得到所有字节的直方图 */
+    for(i = 0; i < n; ++i) {
+        for(b = 0; b < 8; ++b) {
+            ++counts[b][(keys[i] >> (b * 8)) & 0xff];
+        }
+    }
+
+    for(b = 0; b < 8; ++b) {
+        shift = b * 8;
+        /* 所有 key 的这个字节都相同, 跳过 */
+        if(counts[b][(keys[0] >> shift) & 0xff] == n) continue;
+
+        for(sum = 0, i = 0; i < 256; ++i) {
+            tmp = counts[b][i];
+            counts[b][i] = sum;
+            sum += tmp;
+        }
+        for(i = 0; i < n; ++i) {
+            pos = counts[b][(keys[i] >> shift) & 0xff]++;
+            keys2[pos] = keys[i];
+            if(objs) objs2[pos] = objs[i];
+        }
+
+        ktmp = keys; keys = keys2; keys2 = ktmp;
+        otmp = objs; objs = objs2; objs2 = otmp;
+    }
+
+    if(keys != keys_in) {
+        memcpy(keys_in, keys, sizeof(uint64_t) * n);
+        if(objs) memcpy(objs_in, objs, sizeof(void*) * n);
+    }
+}
+
+bool csort_radix_sort_u64(csort_radix *ctx, uint64_t *keys, size_t n)
+{
+    csort_radix tmp = {NULL, 0, NULL, 0};
+    csort_radix *radix = ctx ? ctx : &tmp;
+    uint64_t *keys2 = NULL;
+
+    if(n < 2) return true;
+
+    keys2 = (uint64_t*)csort_radix_buf(radix, sizeof(uint64_t) * n);
+    if(NULL == keys2) return false;
+
+    csort_radix_lsd(keys, NULL, n, keys2, NULL);
+
+    free(tmp.buf);
+
+    return true;
+}
+
+bool csort_radix_sort(csort_radix *ctx, void **objs, size_t n, csort_cb_key key)
+{
+    csort_radix tmp = {NULL, 0, NULL, 0};
+    csort_radix *radix = ctx ? ctx : &tmp;
+    uint64_t *keys = NULL;
+    void **objs2 = NULL;
+    size_t i = 0;
+
+    if(n < 2) return true;
+
+    /* keys, keys2, objs2 */
+    keys = (uint64_t*)csort_radix_buf(radix, (sizeof(uint64_t) * 2 + sizeof(void*)) * n);
+    if(NULL == keys) return false;
+    objs2 = (void**)(keys + 2 * n);
+
+    for(i = 0; i < n; ++i) {
+        keys[i] = key(objs[i]);
+    }
+    csort_radix_lsd(keys, objs, n, keys + n, objs2);
+
+    free(tmp.buf);
+
+    return true;
+}
+
+/*
+ * 待处理的区间互不相交且至少有 2 个元素, 最多同时存在 n / 2 个
+ */
+static bool csort_radix_reserve_parts(csort_radix *ctx, size_t n)
+{
+    csort_radix_part *parts = NULL;
+    size_t size = n / 2 + 1;
+
+    if(size <= ctx->parts_alloc) return true;
+
+    parts = (csort_radix_part*)malloc(sizeof(csort_radix_part) * size);
+    if(NULL == parts) return false;
+
+    free(ctx->parts);
+    ctx->parts = parts;
+    ctx->parts_alloc = size;
+
+    return true;
+}
+
+static void csort_radix_push(csort_radix *ctx, size_t *cnt, size_t first, size_t n, size_t depth)
+{
+    ctx->parts[*cnt].first = first;
+    ctx->parts[*cnt].n     = n;
+    ctx->parts[*cnt].depth = depth;
+    ++(*cnt);
+}
+
+/* 前 depth 个字符都相同, 从 depth 开始比较 */
+static void csort_radix_str_insertion(const char **strs, void **objs, size_t n, size_t depth)
+{
+    const char *s = NULL;
+    void *o = NULL;
+    size_t i = 0;
+    size_t j = 0;
+
+    for(i = 1; i < n; ++i) {
+        s = strs[i];
+        o = objs[i];
+        for(j = i; j > 0 && strcmp(s + depth, strs[j - 1] + depth) < 0; --j) {
+            strs[j] = strs[j - 1];
+            objs[j] = objs[j - 1];
+        }
+        strs[j] = s;
+        objs[j] = o;
+    }
+}
+
+#define CSORT_RADIX_BYTE(str, depth) ((unsigned char)(str)[depth])
+
+bool csort_radix_sort_str(csort_radix *ctx, void **objs, size_t n, csort_cb_str str)
+{
+    csort_radix tmp = {NULL, 0, NULL, 0};
+    csort_radix *radix = ctx ? ctx : &tmp;
+    csort_radix_part part;
+    const char **strs = NULL;
+    const char *s = NULL;
+    const char *t = NULL;
+    void *o = NULL;
+    size_t counts[256];
+    size_t heads[256];
+    size_t ends[256];
+    size_t cnt = 0;
+    size_t i = 0;
+    size_t pos = 0;
+    bool ret = false;
+    int c = 0;
+    int b = 0;
+
+    if(n < 2) return true;
+
+    strs = (const char**)csort_radix_buf(radix, sizeof(char*) * n);
+    if(NULL == strs || !csort_radix_reserve_parts(radix, n)) goto out;
+
+    for(i = 0; i < n; ++i) {
+        strs[i] = str(objs[i]);
+    }
+    csort_radix_push(radix, &cnt, 0, n, 0);
+
+    while(cnt > 0) {
+        part = radix->parts[--cnt];
+
+        if(part.n < CSORT_RADIX_STR_MIN) {
+            csort_radix_str_insertion(strs + part.first, objs + part.first, part.n, part.depth);
+            continue;
+        }
+
+        memset(counts, 0, sizeof(counts));
+        for(i = part.first; i < part.first + part.n; ++i) {
+            ++counts[CSORT_RADIX_BYTE(strs[i], part.depth)];
+        }
+
+        /* 所有字符串在 depth 处都相同, 直接比较下一个字符 */
+        c = CSORT_RADIX_BYTE(strs[part.first], part.depth);
+        if(counts[c] == part.n) {
+            if(c != 0) {
+                ++part.depth;
+                radix->parts[cnt++] = part;
+            }
+            continue;
+        }
+
+        for(pos = part.first, c = 0; c < 256; ++c) {
+            heads[c] = pos;
+            pos += counts[c];
+            ends[c] = pos;
+        }
+
+        /* 原地把每个元素交换到它所在的桶 */
+        for(c = 0; c < 256; ++c) {
+            while(heads[c] < ends[c]) {
+                s = strs[heads[c]];
+                o = objs[heads[c]];
+                while((b = CSORT_RADIX_BYTE(s, part.depth)) != c) {
+                    pos = heads[b]++;
+                    t = strs[pos]; strs[pos] = s; s = t;
+                    CSORT_SWAP(o, objs[pos]);
+                }
+                strs[heads[c]] = s;
+                objs[heads[c]] = o;
+                ++heads[c];
+            }
+        }
+
+        /* 桶 0 中的字符串已经结束, 都相等 */
+        for(pos = part.first + counts[0], c = 1; c < 256; pos += counts[c], ++c) {
+            if(counts[c] > 1) {
+                csort_radix_push(radix, &cnt, pos, counts[c], part.depth + 1);
+            }
+        }
+    }
+    ret = true;
+
+out:
+    free(tmp.buf);
+    free(tmp.parts);
+
+    return ret;
+}
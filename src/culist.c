@@ -0,0 +1,356 @@
+/* {{{
+ * =============================================================================
+ *      Filename    :   culist.c
+ *      Description :
+ *      Created     :   2026-10-19 15:21:05
+ *      Author      :   Wu Hong
+ * =============================================================================
+ }}} */
+#include <string.h>
+#include "culist.h"
+
+static culist_node* culist_node_new(culist *list, unsigned short first)
+{
+    culist_node *node = list->spare;
+
+    if(node) {
+        list->spare = NULL;
+    } else {
+        node = (culist_node*)malloc(sizeof(culist_node));
+        if(NULL == node) return NULL;
+    }
+
+    node->prev  = node->next = NULL;
+    node->first = first;
+    node->count = 0;
+
+    return node;
+}
+
+static void culist_node_release(culist *list, culist_node *node)
+{
+    if(NULL == list->spare) {
+        list->spare = node;
+    } else {
+        free(node);
+    }
+}
+
+/*
+ * Unlink the empty node from the list and release it.
+ */
+static void culist_node_remove(culist *list, culist_node *node)
+{
+    node->prev ? (node->prev->next = node->next) : (list->head = node->next);
+    node->next ? (node->next->prev = node->prev) : (list->tail = node->prev);
+
+    culist_node_release(list, node);
+}
+
+culist* culist_new(void)
+{
+    return (culist*)calloc(1, sizeof(culist));
+}
+
+void culist_clear(culist *list)
+{
+    culist_node  *node = list->head;
+    culist_node  *next = NULL;
+    unsigned int idx   = 0;
+
+    while(node) {
+        next = node->next;
+
+        for(idx = node->first; idx < (unsigned int)(node->first + node->count); ++idx) {
+            cobj_free(node->vals[idx]);
+        }
+        free(node);
+
+        node = next;
+    }
+
+    list->head = NULL;
+    list->tail = NULL;
+    list->len  = 0;
+}
+
+void culist_free(culist *list)
+{
+    if(list) {
+        culist_clear(list);
+        free(list->spare);
+        free(list);
+    }
+}
+
+void culist_print(const culist* list)
+{
+    culist_iter iter = culist_begin((culist*)list);
+    void *obj  = NULL;
+
+    printf("[");
+    culist_iter_foreach_obj(&iter, obj) {
+        cobj_print(obj);
+        printf(", ");
+    }
+    printf("]");
+}
+
+unsigned int culist_len(const culist *list)
+{
+    return list ? list->len : 0;
+}
+
+unsigned int culist_size(const culist *list)
+{
+    return culist_len(list);
+}
+
+bool culist_is_empty(const culist *list)
+{
+    return culist_len(list) == 0;
+}
+
+void culist_append(culist *list, void *obj)
+{
+    culist_node *node = list->tail;
+
+    if(node && node->first + node->count >= CULIST_NODE_CAP
+    && node->count < CULIST_NODE_CAP) {
+        /* 前部有空位, 整体前移 */
+        memmove(node->vals, node->vals + node->first, sizeof(void*) * node->count);
+        node->first = 0;
+    }
+
+    if(NULL == node || node->count >= CULIST_NODE_CAP) {
+        node = culist_node_new(list, 0);
+        if(NULL == node) return;
+
+        node->prev = list->tail;
+        list->tail ? (list->tail->next = node) : (list->head = node);
+        list->tail = node;
+    }
+
+    node->vals[node->first + node->count] = obj;
+    ++node->count;
+    ++list->len;
+}
+
+void culist_prepend(culist *list, void *obj)
+{
+    culist_node *node = list->head;
+
+    if(node && node->first == 0 && node->count < CULIST_NODE_CAP) {
+        /* 后部有空位, 整体后移 */
+        memmove(node->vals + CULIST_NODE_CAP - node->count, node->vals,
+                sizeof(void*) * node->count);
+        node->first = CULIST_NODE_CAP - node->count;
+    }
+
+    if(NULL == node || node->count >= CULIST_NODE_CAP) {
+        node = culist_node_new(list, CULIST_NODE_CAP);
+        if(NULL == node) return;
+
+        node->next = list->head;
+        list->head ? (list->head->prev = node) : (list->tail = node);
+        list->head = node;
+    }
+
+    node->vals[--node->first] = obj;
+    ++node->count;
+    ++list->len;
+}
+
+void* culist_pop_front(culist *list)
+{
+    culist_node *node = list->head;
+    void *obj = NULL;
+
+    if(NULL == node) return NULL;
+
+    obj = node->vals[node->first++];
+    --list->len;
+    if(--node->count == 0) {
+        culist_node_remove(list, node);
+    }
+
+    return obj;
+}
+
+void* culist_pop_back(culist *list)
+{
+    culist_node *node = list->tail;
+    void *obj = NULL;
+
+    if(NULL == node) return NULL;
+
+    obj = node->vals[node->first + node->count - 1];
+    --list->len;
+    if(--node->count == 0) {
+        culist_node_remove(list, node);
+    }
+
+    return obj;
+}
+
+void* culist_begin_obj(culist *list)
+{
+    return list->head ? list->head->vals[list->head->first] : NULL;
+}
+
+void* culist_last_obj(culist *list)
+{
+    culist_node *node = list->tail;
+
+    return node ? node->vals[node->first + node->count - 1] : NULL;
+}
+
+/*
+ * culist iterator
+ */
+static void culist_iter_init(culist_iter *iter, culist *list, culist_node *node,
+                             unsigned short idx, culist_iter_dir dir)
+{
+    iter->list = list;
+    iter->node = node;
+    iter->idx  = idx;
+    iter->dir  = dir;
+}
+
+culist_iter culist_begin(culist *list)
+{
+    culist_iter iter;
+
+    culist_iter_init(&iter, list, list->head,
+                     list->head ? list->head->first : 0, CULIST_ITER_DIR_FORWORD);
+
+    return iter;
+}
+
+culist_iter culist_rbegin(culist *list)
+{
+    culist_iter iter;
+    culist_node *node = list->tail;
+
+    culist_iter_init(&iter, list, node,
+                     node ? node->first + node->count - 1 : 0,
+                     CULIST_ITER_DIR_BACKWORD);
+
+    return iter;
+}
+
+void* culist_iter_obj(culist_iter *iter)
+{
+    return iter->node ? iter->node->vals[iter->idx] : NULL;
+}
+
+bool culist_iter_is_end(culist_iter *iter)
+{
+    return iter->node == NULL;
+}
+
+static void culist_iter_forward(culist_iter *iter)
+{
+    culist_node *node = iter->node;
+
+    if(iter->idx + 1 < node->first + node->count) {
+        ++iter->idx;
+    } else {
+        iter->node = node->next;
+        iter->idx  = iter->node ? iter->node->first : 0;
+    }
+}
+
+static void culist_iter_backward(culist_iter *iter)
+{
+    culist_node *node = iter->node;
+
+    if(iter->idx > node->first) {
+        --iter->idx;
+    } else {
+        iter->node = node->prev;
+        iter->idx  = iter->node ? iter->node->first + iter->node->count - 1 : 0;
+    }
+}
+
+void culist_iter_to_next(culist_iter *iter)
+{
+    if(iter->node) {
+        if(CULIST_ITER_DIR_FORWORD == iter->dir) {
+            culist_iter_forward(iter);
+        } else {
+            culist_iter_backward(iter);
+        }
+    }
+}
+
+void culist_iter_to_prev(culist_iter *iter)
+{
+    if(iter->node) {
+        if(CULIST_ITER_DIR_FORWORD == iter->dir) {
+            culist_iter_backward(iter);
+        } else {
+            culist_iter_forward(iter);
+        }
+    }
+}
+
+/*
+ * Return the iterator at the given index, negative index counts from tail.
+ */
+culist_iter culist_at(culist *list, int index)
+{
+    culist_iter iter;
+    culist_node *node = list->head;
+    int         idx   = index;
+
+    if(index < 0) {
+        idx = culist_size(list) + index;
+    }
+
+    if(idx >= 0 && idx < (int)list->len) {
+        while(idx >= node->count) { idx -= node->count; node = node->next; }
+        culist_iter_init(&iter, list, node, node->first + idx, CULIST_ITER_DIR_FORWORD);
+    } else {
+        culist_iter_init(&iter, list, NULL, 0, CULIST_ITER_DIR_FORWORD);
+    }
+
+    return iter;
+}
+
+void* culist_at_obj(culist *list, int index)
+{
+    culist_iter iter = culist_at(list, index);
+
+    return culist_iter_obj(&iter);
+}
+
+/*
+ * Detach the element at iter and return it, the iterator is invalid after.
+ */
+void* culist_pop(culist_iter *iter)
+{
+    culist      *list = iter->list;
+    culist_node *node = iter->node;
+    void *obj = NULL;
+
+    if(NULL == node) return NULL;
+
+    obj = node->vals[iter->idx];
+    memmove(node->vals + iter->idx, node->vals + iter->idx + 1,
+            sizeof(void*) * (node->first + node->count - iter->idx - 1));
+    --list->len;
+    if(--node->count == 0) {
+        culist_node_remove(list, node);
+    }
+    iter->node = NULL;
+
+    return obj;
+}
+
+void culist_remove(culist_iter *iter)
+{
+    void *obj = culist_pop(iter);
+
+    if(obj) cobj_free(obj);
+}
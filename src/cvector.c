@@ -6,14 +6,32 @@
  *      Author      :   Wu Hong
  * =============================================================================
  }}} */
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE     /* mremap */
+#endif
 #include <stdlib.h>
 #include <string.h>
+#include <limits.h>
+#include <stdint.h>
 #include "cvector.h"
+#include "csort.h"
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#define CVECTOR_ENABLE_MMAP
+#endif
+
+#define CVECTOR_SIZE_INIT       16
+/* 超过此大小的数组使用 mmap, 增长时 mremap 只移动页表而不复制数据 */
+#define CVECTOR_MMAP_THRESHOLD  (4 << 20)
+/* 下标为 ssize_t, 元素个数不能超过 PTRDIFF_MAX 个字节能放下的指针数 */
+#define CVECTOR_SIZE_MAX        ((size_t)PTRDIFF_MAX / sizeof(void*))
 
 #define CVECTOR_CHECK_IDX_FULL(v, i, ret) \
     do {    \
-        if((i) < 0 || (i) >= ((v)->size_offset)){ \
-            printf("[CVECTOR]index(%d) out of range(%d)\n", i, (v)->size_offset);\
+        if((i) < 0 || (size_t)(i) >= ((v)->size_offset)){ \
+            printf("[CVECTOR]index(%zd) out of range(%zu)\n", \
+                   (ssize_t)(i), (v)->size_offset); \
             return ret; \
         }   \
     }while(0)
@@ -26,7 +44,13 @@
 /*********************************************************************
  *                          Vector Iterator                          *
  *********************************************************************/
-void cvector_iter_init(cvector_iter *iter, cvector *v, int i)
+/* int 接口的返回值, 超过 INT_MAX 时截断为 INT_MAX */
+static int cvector_int(size_t n)
+{
+    return n > INT_MAX ? INT_MAX : (int)n;
+}
+
+void cvector_iter_init(cvector_iter *iter, cvector *v, ssize_t i)
 {
     iter->v = v;
     iter->i = i;
@@ -39,7 +63,7 @@ void cvector_iter_set_null(cvector_iter *iter)
 
 bool cvector_iter_is_end(const cvector_iter *iter)
 {
-    return iter->i >= cvector_size(iter->v);
+    return iter->i >= (ssize_t)iter->v->size_offset;
 }
 
 bool cvector_iter_is_rend(const cvector_iter *iter)
@@ -49,7 +73,7 @@ bool cvector_iter_is_rend(const cvector_iter *iter)
 
 void* cvector_iter_pobj(cvector_iter *iter)
 {
-    if(iter->i >= 0 && iter->i < cvector_size(iter->v)) {
+    if(iter->i >= 0 && iter->i < (ssize_t)iter->v->size_offset) {
         return CVECTOR_OBJ(iter->v, iter->i);
     } else {
         return NULL;
@@ -86,34 +110,185 @@ void cvector_iter_to_prev(cvector_iter *iter)
     --(iter->i);
 }
 
-void cvector_init(cvector *v)
+#define CVECTOR_IS_INLINE(v) ((v)->objs == (v)->inline_objs)
+
+static void cvector_objs_free(cvector *v)
+{
+    if(CVECTOR_IS_INLINE(v)) return;
+
+#ifdef CVECTOR_ENABLE_MMAP
+    if(v->mapped) {
+        munmap(v->objs, sizeof(void*) * v->size_alloc);
+        v->mapped = false;
+        return;
+    }
+#endif
+    free(v->objs);
+}
+
+/*
+ * 把数组调整为 size_alloc 个元素, 不超过 CVECTOR_INLINE_SIZE 时使用内嵌数组,
+ * 失败时 v 保持不变
+ */
+static bool cvector_realloc(cvector *v, size_t size_alloc)
+{
+    size_t bytes     = sizeof(void*) * size_alloc;
+    bool   is_inline = CVECTOR_IS_INLINE(v);
+    void   **objs    = NULL;
+
+    if(size_alloc > CVECTOR_SIZE_MAX) return false;
+
+    if(size_alloc <= CVECTOR_INLINE_SIZE) {
+        if(!is_inline) {
+            memcpy(v->inline_objs, v->objs, sizeof(void*) * v->size_offset);
+            cvector_objs_free(v);
+            v->objs = v->inline_objs;
+        }
+        v->size_alloc = CVECTOR_INLINE_SIZE;
+        return true;
+    }
+
+#ifdef CVECTOR_ENABLE_MMAP
+    if(bytes >= CVECTOR_MMAP_THRESHOLD) {
+        if(v->mapped) {
+            objs = (void**)mremap(v->objs, sizeof(void*) * v->size_alloc,
+                                  bytes, MREMAP_MAYMOVE);
+        } else {
+            objs = (void**)mmap(NULL, bytes, PROT_READ | PROT_WRITE,
+                                MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if(MAP_FAILED != objs) {
+                memcpy(objs, v->objs, sizeof(void*) * v->size_offset);
+                cvector_objs_free(v);
+            }
+        }
+        if(MAP_FAILED == objs) return false;
+
+#ifdef MADV_HUGEPAGE
+        madvise(objs, bytes, MADV_HUGEPAGE);
+#endif
+        v->mapped = true;
+    } else if(v->mapped) {
+        objs = (void**)malloc(bytes);
+        if(NULL == objs) return false;
+
+        memcpy(objs, v->objs, sizeof(void*) * v->size_offset);
+        cvector_objs_free(v);
+    } else
+#endif
+    if(is_inline) {
+        objs = (void**)malloc(bytes);
+        if(NULL == objs) return false;
+
+        memcpy(objs, v->objs, sizeof(void*) * v->size_offset);
+    } else {
+        objs = (void**)realloc(v->objs, bytes);
+        if(NULL == objs) return false;
+    }
+
+    v->objs = objs;
+    v->size_alloc = size_alloc;
+
+    return true;
+}
+
+/*
+ * 保证还能放入 n 个元素
+ */
+static bool cvector_ensure(cvector *v, size_t n)
+{
+    size_t need = 0;
+    size_t size = v->size_alloc;
+
+    if(n <= v->size_alloc - v->size_offset) return true;
+    if(n > CVECTOR_SIZE_MAX - v->size_offset) {
+        printf("[CVECTOR]size(%zu + %zu) overflow\n", v->size_offset, n);
+        return false;
+    }
+    need = v->size_offset + n;
+
+    /* size 不超过 CVECTOR_SIZE_MAX, 增长后再截断不会溢出 size_t */
+    switch(v->growth) {
+        case CVECTOR_GROWTH_HALF:
+            size += size / 2;
+            break;
+        case CVECTOR_GROWTH_EXACT:
+            break;
+        default:
+            size *= 2;
+            break;
+    }
+    if(size < CVECTOR_SIZE_INIT) size = CVECTOR_SIZE_INIT;
+    if(size < need) size = need;
+    if(size > CVECTOR_SIZE_MAX) size = CVECTOR_SIZE_MAX;
+
+    if(!cvector_realloc(v, size)) {
+        printf("[CVECTOR]alloc(%zu) failed\n", size);
+        return false;
+    }
+
+    return true;
+}
+
+void cvector_init_with_capacity(cvector *v, size_t capacity)
 {
     v->size_offset = 0;
-    v->size_alloc = 16;
-    v->objs = (void**)malloc(sizeof(void*) * v->size_alloc);
+    v->size_alloc  = CVECTOR_INLINE_SIZE;
+    v->objs   = v->inline_objs;
+    v->growth = CVECTOR_GROWTH_DOUBLE;
+    v->mapped = false;
 
-    memset(v->objs, 0, sizeof(void*) * v->size_alloc);
+    cvector_realloc(v, capacity);
 }
 
-cvector* cvector_new(void)
+void cvector_init(cvector *v)
+{
+    cvector_init_with_capacity(v, 0);
+}
+
+cvector* cvector_new_with_capacity(size_t capacity)
 {
     cvector *v = (cvector*)malloc(sizeof(cvector));
 
-    cvector_init(v);
+    if(v) {
+        cvector_init_with_capacity(v, capacity);
+    }
 
     return v;
 }
 
-static void cvector_resize(cvector *v)
+cvector* cvector_new(void)
 {
-    v->size_alloc *= 2;
-    v->objs = (void**)realloc(v->objs, sizeof(void*) * v->size_alloc);
+    return cvector_new_with_capacity(0);
 }
 
 void cvector_release(cvector *v)
 {
     cvector_clear(v);
-    free(v->objs);
+    cvector_realloc(v, 0);
+}
+
+size_t cvector_capacity(const cvector *v)
+{
+    return v->size_alloc;
+}
+
+bool cvector_reserve(cvector *v, size_t capacity)
+{
+    if(capacity <= v->size_alloc) return true;
+
+    return cvector_realloc(v, capacity);
+}
+
+void cvector_shrink_to_fit(cvector *v)
+{
+    if(v->size_offset < v->size_alloc) {
+        cvector_realloc(v, v->size_offset);
+    }
+}
+
+void cvector_set_growth(cvector *v, cvector_growth growth)
+{
+    v->growth = (unsigned char)growth;
 }
 
 void cvector_free(cvector *v)
@@ -126,7 +301,7 @@ void cvector_free(cvector *v)
 
 void cvector_clear(cvector *v)
 {
-    int i = 0;
+    size_t i = 0;
     for(i = 0; i < v->size_offset; ++i) {
         cobj_free(CVECTOR_OBJ(v, i));
     }
@@ -140,17 +315,22 @@ bool cvector_is_empty(const cvector *v)
 
 int  cvector_length(const cvector *v)
 {
-    return v->size_offset;
+    return cvector_int(v->size_offset);
 }
 
 int  cvector_size(const cvector *v)
+{
+    return cvector_int(v->size_offset);
+}
+
+size_t cvector_size64(const cvector *v)
 {
     return v->size_offset;
 }
 
 void cvector_print(const cvector *v)
 {
-    int i = 0;
+    size_t i = 0;
     printf("[");
     for(i = 0; i < v->size_offset; ++i) {
         cobj_print(CVECTOR_OBJ(v, i));
@@ -161,16 +341,17 @@ void cvector_print(const cvector *v)
     printf("]");
 }
 
-void cvector_remove_at_range(cvector *v, int first, int last)
+void cvector_remove_at_range64(cvector *v, ssize_t first, ssize_t last)
 {
-    int idx = 0;
-    int length = last - first;
+    ssize_t idx = 0;
+    ssize_t length = 0;
 
-    if(last > cvector_size(v)) {
-        length = cvector_size(v) - first;
+    if(last > (ssize_t)v->size_offset) {
+        last = v->size_offset;
     }
+    length = last - first;
 
-    if(length == 0) return;
+    if(length <= 0) return;
 
     CVECTOR_CHECK_IDX(v, first);
 
@@ -179,30 +360,38 @@ void cvector_remove_at_range(cvector *v, int first, int last)
         cobj_free(v->objs[idx]);
     }
 
+    memmove(v->objs + first, v->objs + first + length,
+            sizeof(void*) * (v->size_offset - first - length));
     v->size_offset -= length;
-    for(idx = first; idx < cvector_size(v); ++idx) {
-        v->objs[idx] = v->objs[idx + length];
-    }
+}
+
+void cvector_remove_at_range(cvector *v, int first, int last)
+{
+    cvector_remove_at_range64(v, first, last);
+}
 
+void cvector_remove_at64(cvector *v, ssize_t i)
+{
+    cvector_remove_at_range64(v, i, i + 1);
 }
 
 void cvector_remove_at(cvector *v, int i)
 {
-    cvector_remove_at_range(v, i, i + 1);
+    cvector_remove_at64(v, i);
 }
 
 void cvector_remove(cvector_iter *iter)
 {
-    return cvector_remove_at(iter->v, iter->i);
+    return cvector_remove_at64(iter->v, iter->i);
 }
 
 void cvector_remove_range(cvector_iter *iter_first, cvector_iter *iter_last)
 {
-    return cvector_remove_at_range(iter_first->v, iter_first->i, iter_last->i + 1);
+    return cvector_remove_at_range64(iter_first->v, iter_first->i, iter_last->i + 1);
 }
 
 
-void cvector_replace(cvector *v, int i, void *obj)
+void cvector_replace64(cvector *v, ssize_t i, void *obj)
 {
     void *obj_old = NULL;
 
@@ -210,98 +399,172 @@ void cvector_replace(cvector *v, int i, void *obj)
 
     obj_old = CVECTOR_OBJ(v, i);
     v->objs[i] = obj;
-    cobj_destory(obj_old);
+    if(obj != obj_old) {
+        cobj_free(obj_old);
+    }
 }
 
-void cvector_insert(cvector *v, int i, void *obj)
+void cvector_replace(cvector *v, int i, void *obj)
+{
+    cvector_replace64(v, i, obj);
+}
+
+/*
+ * 在 i 处空出 n 个位置, 返回实际的位置, 失败时返回 -1
+ */
+static ssize_t cvector_open_gap(cvector *v, ssize_t i, size_t n)
 {
-    int idx = 0;
-    int pos = i;
+    ssize_t len = (ssize_t)v->size_offset;
 
-    if(pos < 0) { pos += cvector_length(v); }
+    if(i < 0) { i += len; }
 
-    if(pos < 0) { pos = 0; }
-    else if(pos > cvector_length(v)) { pos = cvector_length(v); }
+    if(i < 0) { i = 0; }
+    else if(i > len) { i = len; }
 
-    /* check is need adjust size */
-    if(v->size_offset + 1 >= v->size_alloc) {
-        cvector_resize(v);
-    }
+    if(!cvector_ensure(v, n)) return -1;
 
-    for(idx = v->size_offset - 1; idx >= i; --idx) {
-        v->objs[idx + 1] = v->objs[idx];
-    }
-    v->objs[i] = obj;
-    ++(v->size_offset);
+    memmove(v->objs + i + n, v->objs + i, sizeof(void*) * (v->size_offset - i));
+    v->size_offset += n;
+
+    return i;
+}
+
+void cvector_insert64(cvector *v, ssize_t i, void *obj)
+{
+    cvector_insert_range64(v, i, &obj, 1);
+}
+
+void cvector_insert(cvector *v, int i, void *obj)
+{
+    cvector_insert_range64(v, i, &obj, 1);
 }
 
 void cvector_insert_with_iter(cvector *v, cvector_iter *iter, void *obj)
 {
-    cvector_insert(v, iter->i, obj);
+    cvector_insert64(v, iter->i, obj);
+}
+
+void cvector_insert_range64(cvector *v, ssize_t i, void **objs, size_t n)
+{
+    if(0 == n) return;
+
+    i = cvector_open_gap(v, i, n);
+    if(i < 0) return;
+
+    memcpy(v->objs + i, objs, sizeof(void*) * n);
+}
+
+void cvector_insert_range(cvector *v, int i, void **objs, int n)
+{
+    if(n <= 0) return;
+
+    cvector_insert_range64(v, i, objs, n);
 }
 
 void cvector_append(cvector *v, void *obj)
 {
-    /* check is need adjust size */
-    if(v->size_offset + 1 >= v->size_alloc) {
-        cvector_resize(v);
-    }
+    if(!cvector_ensure(v, 1)) return;
 
     v->objs[v->size_offset++] = obj;
 }
 
+void cvector_append_array64(cvector *v, void **objs, size_t n)
+{
+    if(0 == n || !cvector_ensure(v, n)) return;
+
+    memcpy(v->objs + v->size_offset, objs, sizeof(void*) * n);
+    v->size_offset += n;
+}
+
+void cvector_append_array(cvector *v, void **objs, int n)
+{
+    if(n <= 0) return;
+
+    cvector_append_array64(v, objs, n);
+}
+
 void cvector_prepend(cvector *v, void *obj)
 {
-    int idx = 0;
+    cvector_insert_range64(v, 0, &obj, 1);
+}
 
-    /* check is need adjust size */
-    if(v->size_offset + 1 >= v->size_alloc) {
-        cvector_resize(v);
-    }
+void cvector_extend(cvector *v, cvector *other)
+{
+    if(v == other) return;
 
-    for(idx = v->size_offset - 1; idx >= 0; --idx) {
-        v->objs[idx + 1] = v->objs[idx];
-    }
-    v->objs[0] = obj;
-    ++(v->size_offset);
+    cvector_splice64(v, v->size_offset, other, 0, other->size_offset);
 }
 
-void* cvector_pop_at(cvector *v, int i)
+void cvector_splice64(cvector *dst, ssize_t i, cvector *src,
+                      ssize_t first, ssize_t last)
 {
-    int idx = 0;
-    void *obj = CVECTOR_OBJ(v, i);
+    ssize_t n = 0;
 
-    for(idx = i; idx < v->size_offset - 1; ++idx) {
-        v->objs[idx] = v->objs[idx + 1];
-    }
+    if(dst == src) return;
+    if(first < 0) first = 0;
+    if(last > (ssize_t)src->size_offset) last = src->size_offset;
+    n = last - first;
+    if(n <= 0) return;
+
+    i = cvector_open_gap(dst, i, n);
+    if(i < 0) return;
+
+    memcpy(dst->objs + i, src->objs + first, sizeof(void*) * n);
+    memmove(src->objs + first, src->objs + last,
+            sizeof(void*) * (src->size_offset - last));
+    src->size_offset -= n;
+}
+
+void cvector_splice(cvector *dst, int i, cvector *src, int first, int last)
+{
+    cvector_splice64(dst, i, src, first, last);
+}
+
+void* cvector_pop_at64(cvector *v, ssize_t i)
+{
+    void *obj = NULL;
+
+    CVECTOR_CHECK_IDX_RETURN_NULL(v, i);
 
+    obj = CVECTOR_OBJ(v, i);
+    memmove(v->objs + i, v->objs + i + 1, sizeof(void*) * (v->size_offset - i - 1));
     --(v->size_offset);
 
     return obj;
 }
 
+void* cvector_pop_at(cvector *v, int i)
+{
+    return cvector_pop_at64(v, i);
+}
+
 void* cvector_pop(cvector *v, cvector_iter *iter)
 {
-    return cvector_pop_at(v, iter->i);
+    return cvector_pop_at64(v, iter->i);
 }
 
 void* cvector_pop_front(cvector *v)
 {
-    return cvector_pop_at(v, 0);
+    return cvector_pop_at64(v, 0);
 }
 
 void* cvector_pop_back(cvector *v)
 {
-    return cvector_pop_at(v, v->size_offset - 1);
+    return cvector_pop_at64(v, (ssize_t)v->size_offset - 1);
 }
 
-void* cvector_at(cvector *v, int i)
+void* cvector_at64(cvector *v, ssize_t i)
 {
     CVECTOR_CHECK_IDX_RETURN_NULL(v, i);
 
     return CVECTOR_OBJ(v, i);
 }
 
+void* cvector_at(cvector *v, int i)
+{
+    return cvector_at64(v, i);
+}
+
 void*  cvector_at_first(cvector *v)
 {
     return CVECTOR_OBJ(v, 0);
@@ -311,3 +574,57 @@ void*  cvector_at_last(cvector *v)
 {
     return CVECTOR_OBJ(v, v->size_offset - 1);
 }
+
+void cvector_sort(cvector *v, cobj_cb_cmp cmp)
+{
+    csort_sort(v->objs, v->size_offset, cmp);
+}
+
+void cvector_stable_sort(cvector *v, cobj_cb_cmp cmp)
+{
+    csort_stable_sort(v->objs, v->size_offset, cmp);
+}
+
+void cvector_sort_parallel(cvector *v, cobj_cb_cmp cmp, int nthreads)
+{
+    csort_sort_parallel(v->objs, v->size_offset, cmp, nthreads);
+}
+
+ssize_t cvector_bsearch64(const cvector *v, const void *obj, cobj_cb_cmp cmp)
+{
+    size_t i = csort_lower_bound(v->objs, v->size_offset, obj, cmp);
+
+    if(NULL == cmp) cmp = cobj_cmp;
+    if(i < v->size_offset && 0 == cmp(CVECTOR_OBJ(v, i), obj)) {
+        return (ssize_t)i;
+    }
+
+    return -1;
+}
+
+size_t cvector_lower_bound64(const cvector *v, const void *obj, cobj_cb_cmp cmp)
+{
+    return csort_lower_bound(v->objs, v->size_offset, obj, cmp);
+}
+
+size_t cvector_upper_bound64(const cvector *v, const void *obj, cobj_cb_cmp cmp)
+{
+    return csort_upper_bound(v->objs, v->size_offset, obj, cmp);
+}
+
+int  cvector_bsearch(const cvector *v, const void *obj, cobj_cb_cmp cmp)
+{
+    ssize_t i = cvector_bsearch64(v, obj, cmp);
+
+    return i < 0 ? -1 : cvector_int(i);
+}
+
+int  cvector_lower_bound(const cvector *v, const void *obj, cobj_cb_cmp cmp)
+{
+    return cvector_int(cvector_lower_bound64(v, obj, cmp));
+}
+
+int  cvector_upper_bound(const cvector *v, const void *obj, cobj_cb_cmp cmp)
+{
+    return cvector_int(cvector_upper_bound64(v, obj, cmp));
+}
@@ -0,0 +1,177 @@
+/* {{{
+ * =============================================================================
+ *      Filename    :   bench_clfqueue.c
+ *      Description :   clfqueue 与 clist + csem 工作队列的吞吐量对比
+ *
+ *          ./cstl_bench [producers] [consumers] [messages per producer]
+ *      Created     :   2026-10-19 17:20:12
+ *      Author      :   Wu Hong
+ * =============================================================================
+ }}} */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include "clist.h"
+#include "csem.h"
+#include "clfqueue.h"
+
+#define BENCH_BATCH 32
+
+typedef struct bench_ctx
+{
+    clist       *list;
+    csem        *items;
+    clfqueue    *queue;
+    int         batch;
+    unsigned    msgs;       /* 每个线程生产 / 消费的消息数 */
+} bench_ctx;
+
+static void* bench_list_producer(void *arg)
+{
+    bench_ctx *ctx = (bench_ctx*)arg;
+    uintptr_t i = 0;
+
+    for(i = 1; i <= ctx->msgs; ++i) {
+        clist_lock(ctx->list);
+        clist_append(ctx->list, (void*)i);
+        clist_unlock(ctx->list);
+        csem_up(ctx->items);
+    }
+
+    return NULL;
+}
+
+static void* bench_list_consumer(void *arg)
+{
+    bench_ctx *ctx = (bench_ctx*)arg;
+    unsigned i = 0;
+
+    for(i = 0; i < ctx->msgs; ++i) {
+        csem_down(ctx->items);
+        clist_lock(ctx->list);
+        clist_pop_front(ctx->list);
+        clist_unlock(ctx->list);
+    }
+
+    return NULL;
+}
+
+static void* bench_lfq_producer(void *arg)
+{
+    bench_ctx *ctx = (bench_ctx*)arg;
+    void *objs[BENCH_BATCH];
+    uintptr_t i = 1;
+    unsigned n = 0;
+    unsigned j = 0;
+
+    while(i <= ctx->msgs) {
+        n = ctx->batch ? BENCH_BATCH : 1;
+        if(n > ctx->msgs - i + 1) n = ctx->msgs - i + 1;
+        for(j = 0; j < n; ++j) objs[j] = (void*)(i + j);
+        for(j = 0; j < n; ) {
+            j += clfqueue_append_batch(ctx->queue, objs + j, n - j);
+            if(j < n) sched_yield();
+        }
+        i += n;
+    }
+
+    return NULL;
+}
+
+static void* bench_lfq_consumer(void *arg)
+{
+    bench_ctx *ctx = (bench_ctx*)arg;
+    void *objs[BENCH_BATCH];
+    unsigned cnt = 0;
+    unsigned n = 0;
+
+    while(cnt < ctx->msgs) {
+        n = ctx->batch ? BENCH_BATCH : 1;
+        if(n > ctx->msgs - cnt) n = ctx->msgs - cnt;
+        n = clfqueue_pop_front_batch(ctx->queue, objs, n);
+        if(n == 0) sched_yield();
+        cnt += n;
+    }
+
+    return NULL;
+}
+
+static double bench_now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void bench_run(const char *name, bench_ctx *ctx, int producers, int consumers,
+                      void* (*producer)(void*), void* (*consumer)(void*))
+{
+    pthread_t *tids = (pthread_t*)malloc(sizeof(pthread_t) * (producers + consumers));
+    bench_ctx pctx = *ctx;
+    bench_ctx cctx = *ctx;
+    bench_ctx first;
+    uint64_t  total = (uint64_t)ctx->msgs * producers;
+    double    start = 0;
+    double    secs = 0;
+    int       i = 0;
+
+    /* 消费者平分所有消息, 余数由第一个消费者处理 */
+    cctx.msgs = total / consumers;
+    first = cctx;
+    first.msgs += total % consumers;
+
+    start = bench_now();
+    for(i = 0; i < consumers; ++i) {
+        pthread_create(&tids[i], NULL, consumer, i == 0 ? &first : &cctx);
+    }
+    for(i = 0; i < producers; ++i) {
+        pthread_create(&tids[consumers + i], NULL, producer, &pctx);
+    }
+    for(i = 0; i < producers + consumers; ++i) {
+        pthread_join(tids[i], NULL);
+    }
+    secs = bench_now() - start;
+
+    printf("%-24s %10.0f msgs/sec (%.3f s)\n", name, total / secs, secs);
+    free(tids);
+}
+
+int main(int argc, char *argv[])
+{
+    int producers = argc > 1 ? atoi(argv[1]) : 4;
+    int consumers = argc > 2 ? atoi(argv[2]) : 4;
+    bench_ctx ctx = {NULL, NULL, NULL, 0, 0};
+
+    ctx.msgs = argc > 3 ? (unsigned)atoi(argv[3]) : 1000000;
+    if(producers <= 0 || consumers <= 0 || ctx.msgs == 0) {
+        fprintf(stderr, "usage: %s [producers] [consumers] [messages per producer]\n", argv[0]);
+        return 1;
+    }
+
+    printf("producers %d, consumers %d, messages %u per producer\n",
+           producers, consumers, ctx.msgs);
+
+    ctx.list  = clist_new();
+    ctx.items = csem_new(0);
+    bench_run("clist + csem", &ctx, producers, consumers,
+              bench_list_producer, bench_list_consumer);
+    clist_free(ctx.list);
+    csem_free(ctx.items);
+
+    ctx.list  = NULL;
+    ctx.items = NULL;
+    ctx.queue = clfqueue_new(1024);
+    bench_run("clfqueue", &ctx, producers, consumers,
+              bench_lfq_producer, bench_lfq_consumer);
+    ctx.batch = 1;
+    bench_run("clfqueue batch", &ctx, producers, consumers,
+              bench_lfq_producer, bench_lfq_consumer);
+    clfqueue_free(ctx.queue);
+
+    return 0;
+}
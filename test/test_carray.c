@@ -0,0 +1,134 @@
+/* {{{
+ * =============================================================================
+ *      Filename    :   test_carray.c
+ *      Description :
+ *      Created     :   2026-10-19 20:31:18
+ *      Author      :   Wu Hong
+ * =============================================================================
+ }}} */
+#include <stdlib.h>
+#include <stdint.h>
+#include <CUnit/Console.h>
+#include "carray.h"
+
+typedef struct test_rec
+{
+    uint32_t id;
+    uint16_t flags;
+    double   score;
+} test_rec;
+
+CARRAY_DECLARE(test_rec_array, test_rec)
+CARRAY_DECLARE(test_int_array, int)
+
+void test_carray(void)
+{
+    carray recs;
+    carray *ints = test_int_array_new();
+    carray_iter iter;
+    test_rec rec = {0, 0, 0};
+    test_rec *prec = NULL;
+    int vals[10] = {0};
+    int test_cnt = 10000;
+    int i = 0;
+    int *pi = NULL;
+
+    test_rec_array_init(&recs);
+    CU_ASSERT(0 == carray_capacity(&recs));
+    CU_ASSERT(sizeof(test_rec) == recs.elem_size);
+
+    for(i = 0; i < test_cnt; ++i) {
+        rec.id    = i;
+        rec.flags = i & 0xff;
+        rec.score = i / 2.0;
+        test_rec_array_append(&recs, rec);
+    }
+    CU_ASSERT(test_cnt == carray_size(&recs));
+
+    /* 元素是连续存放的 */
+    prec = test_rec_array_data(&recs);
+    for(i = 0; i < test_cnt; ++i) {
+        CU_ASSERT(prec + i == test_rec_array_at(&recs, i));
+        CU_ASSERT((uint32_t)i == test_rec_array_get(&recs, i).id);
+    }
+    CU_ASSERT(NULL == test_rec_array_at(&recs, test_cnt));
+
+    i = 0;
+    carray_foreach(&recs, test_rec, prec) {
+        CU_ASSERT(prec->score == i++ / 2.0);
+    }
+
+    iter = carray_rbegin(&recs);
+    for(i = test_cnt - 1; !carray_iter_is_rend(&iter); carray_iter_to_prev(&iter)) {
+        CU_ASSERT((uint32_t)i-- == ((test_rec*)carray_iter_pobj(&iter))->id);
+    }
+
+    carray_remove_at_range(&recs, 10, test_cnt - 10);
+    CU_ASSERT(20 == carray_size(&recs));
+    CU_ASSERT(test_cnt - 10 == (int)test_rec_array_get(&recs, 10).id);
+
+    CU_ASSERT(test_rec_array_pop_back(&recs, &rec));
+    CU_ASSERT(test_cnt - 1 == (int)rec.id);
+    CU_ASSERT(carray_pop_front(&recs, &rec));
+    CU_ASSERT(0 == rec.id);
+    CU_ASSERT(carray_pop_at(&recs, 0, NULL));
+    CU_ASSERT(2 == test_rec_array_get(&recs, 0).id);
+
+    prec = (test_rec*)carray_emplace_back(&recs);
+    prec->id = 12345;
+    CU_ASSERT(12345 == ((test_rec*)carray_at_last(&recs))->id);
+
+    carray_shrink_to_fit(&recs);
+    CU_ASSERT(18 == carray_capacity(&recs));
+    carray_release(&recs);
+
+    for(i = 0; i < 10; ++i) {
+        vals[i] = i + 10;
+    }
+    carray_append_array(ints, vals, 10);
+    test_int_array_insert(ints, 0, 0);
+    carray_insert_range(ints, 1, vals, 5);
+    test_int_array_set(ints, 1, 1);
+    {
+        int expect[] = {0, 1, 11, 12, 13, 14, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19};
+        i = 0;
+        carray_foreach(ints, int, pi) {
+            CU_ASSERT(expect[i++] == *pi);
+        }
+        CU_ASSERT(16 == i);
+    }
+
+    /* 源数据来自数组自身, 扩容或移动后仍能正确复制 */
+    CU_ASSERT(16 == carray_capacity(ints));
+    carray_append(ints, carray_at(ints, 2));
+    CU_ASSERT(11 == *(int*)carray_at_last(ints));
+    carray_insert_range(ints, 3, carray_at(ints, 1), 4);
+    {
+        int expect[] = {0, 1, 11, 1, 11, 12, 13, 12, 13, 14};
+        for(i = 0; i < 10; ++i) {
+            CU_ASSERT(expect[i] == *(int*)carray_at(ints, i));
+        }
+    }
+    carray_append_array(ints, carray_at(ints, 0), carray_length(ints));
+    CU_ASSERT(42 == carray_length(ints));
+    CU_ASSERT(13 == *(int*)carray_at(ints, 27));
+    CU_ASSERT(11 == *(int*)carray_at_last(ints));
+
+    carray_remove_at(ints, 0);
+    carray_replace(ints, 0, &vals[9]);
+    CU_ASSERT(19 == *(int*)carray_at_first(ints));
+    carray_clear(ints);
+    CU_ASSERT(carray_is_empty(ints));
+    CU_ASSERT(!carray_pop_back(ints, NULL));
+    CU_ASSERT(!carray_pop_front(ints, NULL));
+
+    carray_free(ints);
+}
+
+void add_test_carray(void)
+{
+    CU_pSuite suite = NULL;
+
+    suite = CU_add_suite("carray", NULL, NULL);
+    CU_add_test(suite, "test_carray", test_carray);
+}
@@ -0,0 +1,135 @@
+/* {{{
+ * =============================================================================
+ *      Filename    :   test_cbqueue.c
+ *      Description :
+ *      Created     :   2026-10-19 17:58:16
+ *      Author      :   Wu Hong
+ * =============================================================================
+ }}} */
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <CUnit/Console.h>
+#include "cbqueue.h"
+#include "csem.h"
+#include "cobj_int.h"
+
+#define TEST_BQ_PRODUCERS   4
+#define TEST_BQ_MSGS        20000
+
+typedef struct test_bq_ctx
+{
+    cbqueue     *queue;
+    uint64_t    sum;
+    unsigned    cnt;
+} test_bq_ctx;
+
+static void* test_bq_producer(void *arg)
+{
+    test_bq_ctx *ctx = (test_bq_ctx*)arg;
+    uintptr_t i = 0;
+
+    for(i = 1; i <= TEST_BQ_MSGS; ++i) {
+        cbqueue_push(ctx->queue, (void*)i);
+    }
+
+    return NULL;
+}
+
+static void* test_bq_consumer(void *arg)
+{
+    test_bq_ctx *ctx = (test_bq_ctx*)arg;
+    void *objs[16];
+    unsigned int n = 0;
+
+    while(ctx->cnt < TEST_BQ_PRODUCERS * TEST_BQ_MSGS) {
+        n = cbqueue_pop_batch(ctx->queue, objs, 16);
+        CU_ASSERT(n >= 1 && n <= 16);
+        ctx->cnt += n;
+        while(n) ctx->sum += (uintptr_t)objs[--n];
+    }
+
+    return NULL;
+}
+
+void test_csem_acquire(void)
+{
+    csem *sem = csem_new(3);
+
+    CU_ASSERT(!csem_try_acquire(sem, 4));
+    CU_ASSERT(3 == csem_getvalue(sem));
+    CU_ASSERT(csem_try_acquire(sem, 2));
+    CU_ASSERT(1 == csem_getvalue(sem));
+    csem_release(sem, 5);
+    CU_ASSERT(6 == csem_getvalue(sem));
+    CU_ASSERT(0 == csem_acquire(sem, 6));
+    CU_ASSERT(0 == csem_getvalue(sem));
+
+    csem_free(sem);
+}
+
+void test_cbqueue(void)
+{
+    cbqueue *queue = cbqueue_new(4);
+    void *objs[8];
+    uintptr_t i = 0;
+
+    CU_ASSERT(NULL == cbqueue_new(0));
+    CU_ASSERT(4 == cbqueue_capacity(queue));
+    CU_ASSERT(NULL == cbqueue_try_pop(queue));
+    CU_ASSERT(NULL == cbqueue_pop_timed(queue, 10));
+
+    for(i = 1; i <= 4; ++i) {
+        cbqueue_push(queue, (void*)i);
+    }
+    CU_ASSERT(!cbqueue_try_push(queue, (void*)i));
+    CU_ASSERT(4 == cbqueue_size(queue));
+
+    CU_ASSERT((void*)1 == cbqueue_pop(queue));
+    CU_ASSERT((void*)2 == cbqueue_pop_timed(queue, 10));
+    CU_ASSERT(cbqueue_try_push(queue, (void*)5));
+    CU_ASSERT(cbqueue_try_push(queue, (void*)6));
+
+    /* 跨过环形数组的末尾 */
+    CU_ASSERT(3 == cbqueue_pop_batch(queue, objs, 3));
+    CU_ASSERT((void*)3 == objs[0] && (void*)4 == objs[1] && (void*)5 == objs[2]);
+    CU_ASSERT(1 == cbqueue_pop_batch(queue, objs, 8));
+    CU_ASSERT((void*)6 == objs[0]);
+    CU_ASSERT(0 == cbqueue_size(queue));
+
+    /* 剩余的元素由 cbqueue_free 释放 */
+    cbqueue_push(queue, cobj_int_new(1));
+    cbqueue_push(queue, cobj_int_new(2));
+    cbqueue_free(queue);
+}
+
+void test_cbqueue_threads(void)
+{
+    test_bq_ctx ctx = {cbqueue_new(8), 0, 0};
+    pthread_t   tids[TEST_BQ_PRODUCERS + 1];
+    int         i = 0;
+
+    /* 队列容量远小于消息数, 生产者会被阻塞 */
+    pthread_create(&tids[0], NULL, test_bq_consumer, &ctx);
+    for(i = 1; i <= TEST_BQ_PRODUCERS; ++i) {
+        pthread_create(&tids[i], NULL, test_bq_producer, &ctx);
+    }
+    for(i = 0; i <= TEST_BQ_PRODUCERS; ++i) {
+        pthread_join(tids[i], NULL);
+    }
+
+    CU_ASSERT(TEST_BQ_PRODUCERS * TEST_BQ_MSGS == ctx.cnt);
+    CU_ASSERT((uint64_t)TEST_BQ_PRODUCERS * TEST_BQ_MSGS * (TEST_BQ_MSGS + 1) / 2 == ctx.sum);
+    CU_ASSERT(0 == cbqueue_size(ctx.queue));
+    cbqueue_free(ctx.queue);
+}
+
+void add_test_cbqueue(void)
+{
+    CU_pSuite suite = NULL;
+
+    suite = CU_add_suite("cbqueue", NULL, NULL);
+    CU_add_test(suite, "test_csem_acquire", test_csem_acquire);
+    CU_add_test(suite, "test_cbqueue", test_cbqueue);
+    CU_add_test(suite, "test_cbqueue_threads", test_cbqueue_threads);
+}
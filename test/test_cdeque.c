@@ -0,0 +1,94 @@
+/* {{{
+ * =============================================================================
+ *      Filename    :   test_cdeque.c
+ *      Description :
+ *      Created     :   2026-10-19 19:48:03
+ *      Author      :   Wu Hong
+ * =============================================================================
+ }}} */
+#include <stdlib.h>
+#include <CUnit/Console.h>
+#include "cdeque.h"
+#include "cobj_int.h"
+
+void test_cdeque(void)
+{
+    cdeque dq;
+    cdeque *pdq = cdeque_new_with_capacity(100);
+    cdeque_iter iter;
+    void *obj = NULL;
+    int test_cnt = 1000;
+    int i = 0;
+
+    cdeque_init(&dq);
+    CU_ASSERT(0 == cdeque_capacity(&dq));
+    CU_ASSERT(NULL == cdeque_pop_front(&dq));
+    CU_ASSERT(NULL == cdeque_pop_back(&dq));
+    CU_ASSERT(NULL == cdeque_at_first(&dq));
+
+    /* 交替在两端插入, 结果为 -(n-1) ... -1 0 1 ... (n-1) */
+    for(i = 0; i < test_cnt; ++i) {
+        cdeque_append(&dq, cobj_int_new(i));
+        if(i) cdeque_prepend(&dq, cobj_int_new(-i));
+    }
+    CU_ASSERT(2 * test_cnt - 1 == cdeque_size(&dq));
+    for(i = 0; i < cdeque_size(&dq); ++i) {
+        CU_ASSERT(i - test_cnt + 1 == cobj_int_val(cdeque_at(&dq, i)));
+    }
+    CU_ASSERT(test_cnt - 1 == cobj_int_val(cdeque_at(&dq, -1)));
+    CU_ASSERT(NULL == cdeque_at(&dq, cdeque_size(&dq)));
+
+    i = 1 - test_cnt;
+    iter = cdeque_begin(&dq);
+    for(; !cdeque_iter_is_end(&iter); cdeque_iter_to_next(&iter)) {
+        CU_ASSERT(i++ == cobj_int_val(cdeque_iter_pobj(&iter)));
+    }
+    iter = cdeque_rbegin(&dq);
+    for(; !cdeque_iter_is_rend(&iter); cdeque_iter_to_prev(&iter)) {
+        CU_ASSERT(--i == cobj_int_val(cdeque_iter_pobj(&iter)));
+    }
+
+    cdeque_replace(&dq, 0, cobj_int_new(12345));
+    CU_ASSERT(12345 == cobj_int_val(cdeque_at_first(&dq)));
+    /* 用同一个对象替换时不释放 */
+    cdeque_replace(&dq, 0, cdeque_at_first(&dq));
+    CU_ASSERT(12345 == cobj_int_val(cdeque_at_first(&dq)));
+    cdeque_release(&dq);
+    CU_ASSERT(0 == cdeque_capacity(&dq));
+
+    /* 滑动窗口, 容量不会增长 */
+    CU_ASSERT(128 == cdeque_capacity(pdq));
+    for(i = 0; i < test_cnt * 10; ++i) {
+        cdeque_append(pdq, cobj_int_new(i));
+        if(cdeque_size(pdq) > 100) {
+            obj = cdeque_pop_front(pdq);
+            CU_ASSERT(i - 100 == cobj_int_val(obj));
+            cobj_free(obj);
+        }
+        CU_ASSERT(i == cobj_int_val(cdeque_at_last(pdq)));
+    }
+    CU_ASSERT(128 == cdeque_capacity(pdq));
+
+    /* 在绕回的状态下扩容 */
+    for(i = 0; i < 100; ++i) {
+        cdeque_prepend(pdq, cobj_int_new(-1 - i));
+    }
+    CU_ASSERT(256 == cdeque_capacity(pdq));
+    CU_ASSERT(-100 == cobj_int_val(cdeque_at_first(pdq)));
+    CU_ASSERT(-1 == cobj_int_val(cdeque_at(pdq, 99)));
+    CU_ASSERT(test_cnt * 10 - 100 == cobj_int_val(cdeque_at(pdq, 100)));
+
+    obj = cdeque_pop_back(pdq);
+    CU_ASSERT(test_cnt * 10 - 1 == cobj_int_val(obj));
+    cobj_free(obj);
+
+    cdeque_free(pdq);
+}
+
+void add_test_cdeque(void)
+{
+    CU_pSuite suite = NULL;
+
+    suite = CU_add_suite("cdeque", NULL, NULL);
+    CU_add_test(suite, "test_cdeque", test_cdeque);
+}
@@ -0,0 +1,153 @@
+/* {{{
+ * =============================================================================
+ *      Filename    :   test_cflatmap.c
+ *      Description :
+ *      Created     :   2026-10-20 00:41:15
+ *      Author      :   Wu Hong
+ * =============================================================================
+ }}} */
+#include <stdlib.h>
+#include <CUnit/Console.h>
+#include "cflatmap.h"
+#include "cobj_int.h"
+
+static cobj_int* test_cflatmap_probe(cobj_int *probe, int val)
+{
+    cobj_free(probe);
+
+    return cobj_int_new(val);
+}
+
+/* key 严格递增, value 为 key 的 scale 倍 */
+static bool test_cflatmap_check(const cflatmap *map, int scale)
+{
+    size_t i = 0;
+    int key = 0;
+
+    for(i = 0; i < cflatmap_size(map); ++i) {
+        key = cobj_int_val(cflatmap_key_at(map, i));
+        if(i > 0 && key <= cobj_int_val(cflatmap_key_at(map, i - 1))) return false;
+        if(key * scale != cobj_int_val(cflatmap_value_at(map, i))) return false;
+    }
+
+    return true;
+}
+
+void test_cflatmap(void)
+{
+    int i = 0;
+    int test_cnt = 2000;
+    cflatmap *map = cflatmap_new(NULL);
+    cobj_int *probe = cobj_int_new(1);
+
+    CU_ASSERT(cflatmap_is_empty(map));
+    CU_ASSERT(0 == cflatmap_lower_bound(map, probe));
+    CU_ASSERT(-1 == cflatmap_find(map, probe));
+    CU_ASSERT(NULL == cflatmap_key_at(map, 0));
+
+    /* 逆序插入偶数 */
+    for(i = test_cnt - 1; i >= 0; --i) {
+        CU_ASSERT(cflatmap_set(map, cobj_int_new(i * 2), cobj_int_new(i * 4)));
+    }
+    CU_ASSERT((size_t)test_cnt == cflatmap_size(map));
+    CU_ASSERT(test_cflatmap_check(map, 2));
+
+    for(i = 0; i < test_cnt * 2; ++i) {
+        probe = test_cflatmap_probe(probe, i);
+        CU_ASSERT((size_t)(i + 1) / 2 == cflatmap_lower_bound(map, probe));
+        CU_ASSERT(cflatmap_haskey(map, probe) == (i % 2 == 0));
+        if(i % 2 == 0) {
+            CU_ASSERT(i / 2 == cflatmap_find(map, probe));
+            CU_ASSERT(i * 2 == cobj_int_val(cflatmap_get_value(map, probe)));
+        } else {
+            CU_ASSERT(NULL == cflatmap_get_value(map, probe));
+        }
+    }
+    probe = test_cflatmap_probe(probe, test_cnt * 4);
+    CU_ASSERT((size_t)test_cnt == cflatmap_lower_bound(map, probe));
+
+    /* 替换已有的 key */
+    CU_ASSERT(cflatmap_set(map, cobj_int_new(10), cobj_int_new(-1)));
+    probe = test_cflatmap_probe(probe, 10);
+    CU_ASSERT(-1 == cobj_int_val(cflatmap_get_value(map, probe)));
+    CU_ASSERT((size_t)test_cnt == cflatmap_size(map));
+
+    /* 用已存放的 key 对象设置新的 value */
+    CU_ASSERT(cflatmap_set(map, cflatmap_key_at(map, 5), cobj_int_new(-2)));
+    CU_ASSERT(10 == cobj_int_val(cflatmap_key_at(map, 5)));
+    CU_ASSERT(-2 == cobj_int_val(cflatmap_get_value(map, probe)));
+    CU_ASSERT(cflatmap_set(map, cobj_int_new(10), cflatmap_value_at(map, 5)));
+    CU_ASSERT(-2 == cobj_int_val(cflatmap_get_value(map, probe)));
+
+    cflatmap_del(map, probe);
+    CU_ASSERT(!cflatmap_haskey(map, probe));
+    cflatmap_del(map, probe);
+    CU_ASSERT((size_t)test_cnt - 1 == cflatmap_size(map));
+    CU_ASSERT(test_cflatmap_check(map, 2));
+
+    cflatmap_clear(map);
+    CU_ASSERT(cflatmap_is_empty(map));
+
+    cobj_free(probe);
+    cflatmap_free(map);
+}
+
+void test_cflatmap_bulk(void)
+{
+    int i = 0;
+    int test_cnt = 5000;
+    void **keys = (void**)malloc(sizeof(void*) * test_cnt);
+    void **vals = (void**)malloc(sizeof(void*) * test_cnt);
+    cflatmap *map = NULL;
+    cobj_int *probe = NULL;
+
+    /* 乱序且有重复的 key, 以后出现的为准 */
+    for(i = 0; i < test_cnt; ++i) {
+        keys[i] = cobj_int_new((i * 7919) % (test_cnt / 2) * 3);
+        vals[i] = cobj_int_new(i < test_cnt / 2 ? -1 : cobj_int_val(keys[i]) * 2);
+    }
+    map = cflatmap_build_from(keys, vals, test_cnt, NULL);
+    CU_ASSERT((size_t)test_cnt / 2 == cflatmap_size(map));
+    CU_ASSERT(test_cflatmap_check(map, 2));
+    cflatmap_free(map);
+
+    map = cflatmap_build_from(keys, vals, 0, NULL);
+    CU_ASSERT(cflatmap_is_empty(map));
+
+    /* 分批合并, 与已有的 key 部分重叠 */
+    for(i = 0; i < test_cnt; ++i) {
+        keys[i] = cobj_int_new((i * 7919) % test_cnt);
+        vals[i] = cobj_int_new(-1);
+    }
+    CU_ASSERT(cflatmap_merge(map, keys, vals, test_cnt / 2));
+    CU_ASSERT((size_t)test_cnt / 2 == cflatmap_size(map));
+    for(i = 0; i < test_cnt; ++i) {
+        if(i < test_cnt / 2) {
+            keys[i] = cobj_int_new((i * 7919) % test_cnt);
+        } else {
+            cobj_free(vals[i]);
+        }
+        vals[i] = cobj_int_new(cobj_int_val(keys[i]) * 3);
+    }
+    CU_ASSERT(cflatmap_merge(map, keys, vals, test_cnt));
+    CU_ASSERT(cflatmap_merge(map, keys, vals, 0));
+    CU_ASSERT((size_t)test_cnt == cflatmap_size(map));
+    CU_ASSERT(test_cflatmap_check(map, 3));
+
+    probe = cobj_int_new(test_cnt - 1);
+    CU_ASSERT(test_cnt - 1 == cflatmap_find(map, probe));
+
+    cobj_free(probe);
+    cflatmap_free(map);
+    free(keys);
+    free(vals);
+}
+
+void add_test_cflatmap(void)
+{
+    CU_pSuite suite = NULL;
+
+    suite = CU_add_suite("cflatmap", NULL, NULL);
+    CU_add_test(suite, "test_cflatmap", test_cflatmap);
+    CU_add_test(suite, "test_cflatmap_bulk", test_cflatmap_bulk);
+}
@@ -11,6 +11,16 @@
 #include "chash.h"
 #include "cobj_str.h"
 #include "cobj_int.h"
+#include "chash_tpl.h"
+
+typedef struct test_rec
+{
+    uint64_t id;
+    int      cnt;
+} test_rec;
+
+CHASH_DECLARE(test_u64map, uint64_t, test_rec,
+              chash_tpl_hash_u64, chash_tpl_eq_scalar)
 
 void test_chash_int()
 {
@@ -59,6 +69,295 @@ void test_chash_str()
     chash_free(hash);
 }
 
+void test_chash_small()
+{
+    int i = 0;
+    int cnt = 0;
+    int test_cnt = 100;
+    chash *hash = chash_new();
+    chash_iter *itor = NULL;
+
+    /* 由 small 模式逐步转为桶模式, 每一步都能正确查找 */
+    for(i = 0; i < test_cnt; ++i) {
+        chash_int_set(hash, i, cobj_int_new(i));
+        CU_ASSERT(i + 1 == chash_count(hash));
+        CU_ASSERT(chash_int_haskey(hash, 0));
+        CU_ASSERT(chash_int_haskey(hash, i));
+    }
+
+    chash_int_set(hash, 3, cobj_int_new(300));
+    CU_ASSERT(test_cnt == chash_count(hash));
+    CU_ASSERT(300 == cobj_int_val(chash_int_get(hash, 3)));
+
+    itor = chash_iter_new(hash);
+    while(!chash_iter_is_end(itor)) {
+        cobj_int *key = (cobj_int*)chash_iter_key(itor);
+        cobj_int *val = (cobj_int*)chash_iter_value(itor);
+        CU_ASSERT(cobj_int_val(key) == 3 || cobj_int_val(key) == cobj_int_val(val));
+        ++cnt;
+        chash_iter_next(itor);
+    }
+    chash_iter_free(itor);
+    CU_ASSERT(test_cnt == cnt);
+    chash_free(hash);
+
+    hash = chash_new();
+    for(i = 0; i < 5; ++i) {
+        chash_str_str_set(hash, i % 2 ? "odd" : "even", "v");
+        chash_int_set(hash, i, cobj_int_new(i));
+    }
+    CU_ASSERT(7 == chash_count(hash));
+    chash_int_del(hash, 2);
+    chash_str_del(hash, "odd");
+    CU_ASSERT(5 == chash_count(hash));
+    CU_ASSERT(false == chash_int_haskey(hash, 2));
+    CU_ASSERT(chash_int_haskey(hash, 4));
+    CU_ASSERT(chash_str_haskey(hash, "even"));
+
+    cnt = 0;
+    itor = chash_iter_new(hash);
+    while(!chash_iter_is_end(itor)) {
+        ++cnt;
+        chash_iter_next(itor);
+    }
+    chash_iter_free(itor);
+    CU_ASSERT(5 == cnt);
+
+    chash_reset(hash);
+    CU_ASSERT(0 == chash_count(hash));
+    chash_int_set(hash, 1, cobj_int_new(1));
+    CU_ASSERT(1 == cobj_int_val(chash_int_get(hash, 1)));
+
+    chash_free(hash);
+}
+
+void test_chash_reset()
+{
+    int i = 0;
+    int round = 0;
+    int test_cnt = 1000;
+    chash *hash = chash_new();
+
+    for(round = 0; round < 3; ++round) {
+        for(i = 0; i < test_cnt; ++i) {
+            chash_int_set(hash, i, cobj_int_new(i + round));
+        }
+        CU_ASSERT(test_cnt == chash_count(hash));
+
+        for(i = 0; i < test_cnt; ++i) {
+            cobj_int *obj = (cobj_int*)chash_int_get(hash, i);
+            CU_ASSERT(obj != NULL && cobj_int_val(obj) == i + round);
+        }
+
+        chash_reset(hash);
+        CU_ASSERT(0 == chash_count(hash));
+        CU_ASSERT(false == chash_int_haskey(hash, 0));
+        CU_ASSERT(NULL == chash_int_get(hash, test_cnt - 1));
+    }
+
+    chash_iter *itor = chash_iter_new(hash);
+    CU_ASSERT(chash_iter_is_end(itor));
+    chash_iter_free(itor);
+
+    chash_int_set(hash, 1, cobj_int_new(1));
+    chash_clear(hash);
+    CU_ASSERT(0 == chash_count(hash));
+
+    chash_free(hash);
+}
+
+void test_chash_build()
+{
+    int i = 0;
+    int nthreads = 0;
+    int test_cnt = 10000;
+    void **keys = (void**)malloc(sizeof(void*) * test_cnt);
+    void **vals = (void**)malloc(sizeof(void*) * test_cnt);
+    chash *hash = NULL;
+
+    for(nthreads = 1; nthreads <= 4; nthreads += 3) {
+        /* 后半部分与前半部分 key 重复, 以后出现的为准 */
+        for(i = 0; i < test_cnt; ++i) {
+            keys[i] = cobj_int_new(i % (test_cnt / 2));
+            vals[i] = cobj_int_new(i);
+        }
+
+        hash = chash_build_from(keys, vals, test_cnt, nthreads);
+        CU_ASSERT(test_cnt / 2 == chash_count(hash));
+        for(i = 0; i < test_cnt / 2; ++i) {
+            cobj_int *obj = (cobj_int*)chash_int_get(hash, i);
+            CU_ASSERT(obj != NULL && cobj_int_val(obj) == i + test_cnt / 2);
+        }
+
+        chash_int_set(hash, test_cnt, cobj_int_new(0));
+        CU_ASSERT(test_cnt / 2 + 1 == chash_count(hash));
+        chash_free(hash);
+    }
+
+    keys[0] = cobj_int_new(1);
+    vals[0] = cobj_int_new(2);
+    hash = chash_build_from(keys, vals, 1, 4);
+    CU_ASSERT(2 == cobj_int_val(chash_int_get(hash, 1)));
+    chash_free(hash);
+
+    free(keys);
+    free(vals);
+}
+
+static void test_chash_sum_cb(void *key, void *val, void *arg)
+{
+    *(long*)arg += cobj_int_val((cobj_int*)val);
+}
+
+static void test_chash_merge_cb(void *result, const void *acc)
+{
+    *(long*)result += *(const long*)acc;
+}
+
+static bool test_chash_is_odd_cb(const void *key, const void *val, void *arg)
+{
+    return cobj_int_val((cobj_int*)key) % 2 == 1;
+}
+
+void test_chash_parallel()
+{
+    int i = 0;
+    int part = 0;
+    int cnt = 0;
+    int test_cnt = 10000;
+    long sum = 0;
+    void **keys = NULL;
+    void **vals = NULL;
+    chash *hash = chash_new();
+    chash_iter *itor = NULL;
+
+    for(i = 0; i < test_cnt; ++i) {
+        chash_int_set(hash, i, cobj_int_new(i));
+    }
+
+    /* 各分区互不相交且覆盖全部元素 */
+    for(part = 0; part < 3; ++part) {
+        itor = chash_partition_iter(hash, part, 3);
+        while(!chash_iter_is_end(itor)) {
+            sum += cobj_int_val((cobj_int*)chash_iter_value(itor));
+            ++cnt;
+            chash_iter_next(itor);
+        }
+        chash_iter_free(itor);
+    }
+    CU_ASSERT(test_cnt == cnt);
+    CU_ASSERT((long)test_cnt * (test_cnt - 1) / 2 == sum);
+    CU_ASSERT(NULL == chash_partition_iter(hash, 0, 0));
+    CU_ASSERT(NULL == chash_partition_iter(hash, 3, 3));
+    CU_ASSERT(NULL == chash_partition_iter(hash, -1, 3));
+
+    sum = 0;
+    chash_parallel_reduce(hash, test_chash_sum_cb, test_chash_merge_cb,
+                          &sum, sizeof(sum), 4);
+    CU_ASSERT((long)test_cnt * (test_cnt - 1) / 2 == sum);
+
+    CU_ASSERT(test_cnt / 2 == chash_parallel_remove_if(hash, test_chash_is_odd_cb, NULL, 4));
+    CU_ASSERT(test_cnt / 2 == chash_count(hash));
+    CU_ASSERT(chash_int_haskey(hash, 0));
+    CU_ASSERT(false == chash_int_haskey(hash, 1));
+
+    sum = 0;
+    chash_parallel_for_each(hash, test_chash_sum_cb, &sum, 1);
+    CU_ASSERT((long)(test_cnt / 2) * (test_cnt / 2 - 1) == sum);
+
+    chash_free(hash);
+
+    /* small 模式 */
+    hash = chash_new();
+    for(i = 0; i < 4; ++i) {
+        chash_int_set(hash, i, cobj_int_new(i));
+    }
+    sum = 0;
+    chash_parallel_reduce(hash, test_chash_sum_cb, test_chash_merge_cb,
+                          &sum, sizeof(sum), 4);
+    CU_ASSERT(6 == sum);
+    CU_ASSERT(2 == chash_parallel_remove_if(hash, test_chash_is_odd_cb, NULL, 4));
+    CU_ASSERT(2 == chash_count(hash));
+    chash_free(hash);
+
+    /* 并行建立的桶使用各线程的节点池, 删除和 reset 后重新插入 */
+    keys = (void**)malloc(sizeof(void*) * test_cnt);
+    vals = (void**)malloc(sizeof(void*) * test_cnt);
+    for(i = 0; i < test_cnt; ++i) {
+        keys[i] = cobj_int_new(i);
+        vals[i] = cobj_int_new(i);
+    }
+    hash = chash_build_from(keys, vals, test_cnt, 4);
+    CU_ASSERT(test_cnt / 2 == chash_parallel_remove_if(hash, test_chash_is_odd_cb, NULL, 3));
+    chash_reset(hash);
+    for(i = 0; i < test_cnt; ++i) {
+        chash_int_set(hash, i, cobj_int_new(-i));
+    }
+    CU_ASSERT(test_cnt == chash_count(hash));
+    CU_ASSERT(1 - test_cnt == cobj_int_val(chash_int_get(hash, test_cnt - 1)));
+    CU_ASSERT(test_cnt / 2 == chash_parallel_remove_if(hash, test_chash_is_odd_cb, NULL, 4));
+    chash_free(hash);
+    free(keys);
+    free(vals);
+}
+
+void test_chash_tpl()
+{
+    uint64_t i = 0;
+    uint64_t test_cnt = 10000;
+    uint32_t idx = 0;
+    uint32_t cnt = 0;
+    test_rec rec;
+    test_rec *prec = NULL;
+    test_u64map *hash = test_u64map_new();
+
+    CU_ASSERT(NULL == test_u64map_get(hash, 1));
+    for(i = 0; i < test_cnt; ++i) {
+        rec.id  = i << 32;
+        rec.cnt = (int)i;
+        CU_ASSERT(test_u64map_set(hash, rec.id, rec));
+    }
+    CU_ASSERT(test_cnt == test_u64map_count(hash));
+
+    for(i = 0; i < test_cnt; ++i) {
+        prec = test_u64map_get(hash, i << 32);
+        CU_ASSERT(prec != NULL && prec->id == i << 32 && prec->cnt == (int)i);
+    }
+
+    for(i = 0; i < test_cnt; i += 2) {
+        CU_ASSERT(test_u64map_del(hash, i << 32));
+    }
+    CU_ASSERT(false == test_u64map_del(hash, 0));
+    CU_ASSERT(test_cnt / 2 == test_u64map_count(hash));
+
+    chash_tpl_foreach(test_u64map, hash, idx) {
+        prec = test_u64map_value(hash, idx);
+        CU_ASSERT(prec->id == test_u64map_key(hash, idx) && prec->cnt % 2 == 1);
+        ++cnt;
+    }
+    CU_ASSERT(test_cnt / 2 == cnt);
+
+    /* 删除后的槽位可以重复使用 */
+    for(i = 0; i < test_cnt; i += 2) {
+        rec.id  = i << 32;
+        rec.cnt = (int)i;
+        test_u64map_set(hash, rec.id, rec);
+    }
+    CU_ASSERT(test_cnt == test_u64map_count(hash));
+    CU_ASSERT(test_u64map_haskey(hash, 0));
+
+    /* 超过最大桶数能容纳的个数, 不会无限翻倍 */
+    CU_ASSERT(!test_u64map_reserve(hash, UINT32_MAX));
+    CU_ASSERT(test_u64map_reserve(hash, (uint32_t)test_cnt));
+    CU_ASSERT(test_cnt == test_u64map_count(hash));
+
+    test_u64map_clear(hash);
+    CU_ASSERT(0 == test_u64map_count(hash));
+    CU_ASSERT(false == test_u64map_haskey(hash, 0));
+
+    test_u64map_free(hash);
+}
+
 void add_test_chash(void)
 {
     CU_pSuite pSuite = NULL;
@@ -67,6 +366,11 @@ void add_test_chash(void)
 
     CU_add_test(pSuite, "test_chash_int", test_chash_int);
     CU_add_test(pSuite, "test_chash_str", test_chash_str);
+    CU_add_test(pSuite, "test_chash_small", test_chash_small);
+    CU_add_test(pSuite, "test_chash_reset", test_chash_reset);
+    CU_add_test(pSuite, "test_chash_build", test_chash_build);
+    CU_add_test(pSuite, "test_chash_parallel", test_chash_parallel);
+    CU_add_test(pSuite, "test_chash_tpl", test_chash_tpl);
 }
 
 
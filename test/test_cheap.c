@@ -0,0 +1,159 @@
+/* {{{
+ * =============================================================================
+ *      Filename    :   test_cheap.c
+ *      Description :
+ *      Created     :   2026-10-19 23:36:52
+ *      Author      :   Wu Hong
+ * =============================================================================
+ }}} */
+#include <stdlib.h>
+#include <CUnit/Console.h>
+#include "cheap.h"
+#include "cobj_int.h"
+
+static int test_cheap_cmp_desc(const void *a, const void *b)
+{
+    return cobj_cmp(b, a);
+}
+
+/* 依次取出全部元素, 检查是否有序并返回个数 */
+static int test_cheap_drain(cheap *heap, int order)
+{
+    int cnt = 0;
+    int prev = 0;
+    void *obj = NULL;
+
+    while(NULL != (obj = cheap_pop_min(heap))) {
+        if(cnt > 0) {
+            CU_ASSERT(order * (cobj_int_val(obj) - prev) >= 0);
+        }
+        prev = cobj_int_val(obj);
+        ++cnt;
+        cobj_free(obj);
+    }
+
+    return cnt;
+}
+
+void test_cheap(void)
+{
+    int i = 0;
+    int d = 0;
+    int test_cnt = 5000;
+    cheap *heap = NULL;
+    void *obj = NULL;
+
+    CU_ASSERT(NULL == cheap_new_dary(NULL, 3));
+    CU_ASSERT(NULL == cheap_new_dary(NULL, 32));
+
+    for(d = 2; d <= 16; d *= 2) {
+        heap = cheap_new_dary(NULL, d);
+        CU_ASSERT(cheap_is_empty(heap));
+        CU_ASSERT(NULL == cheap_peek(heap));
+        CU_ASSERT(NULL == cheap_pop_min(heap));
+
+        srand(d);
+        for(i = 0; i < test_cnt; ++i) {
+            cheap_push(heap, cobj_int_new(rand() % 1000));
+            /* 穿插着取出, 让 handle 被复用 */
+            if(i % 3 == 0) {
+                obj = cheap_peek(heap);
+                CU_ASSERT(obj == cheap_pop_min(heap));
+                cobj_free(obj);
+            }
+        }
+        CU_ASSERT((size_t)(test_cnt - (test_cnt + 2) / 3) == cheap_size(heap));
+        CU_ASSERT(test_cnt - (test_cnt + 2) / 3 == test_cheap_drain(heap, 1));
+        CU_ASSERT(cheap_is_empty(heap));
+
+        cheap_free(heap);
+    }
+}
+
+void test_cheap_from_vector(void)
+{
+    int i = 0;
+    int test_cnt = 3000;
+    cvector v;
+    cheap *heap = NULL;
+
+    cvector_init(&v);
+    for(i = 0; i < test_cnt; ++i) {
+        cvector_append(&v, cobj_int_new((i * 7919) % test_cnt));
+    }
+
+    heap = cheap_new_from_vector(&v, test_cheap_cmp_desc, 4);
+    CU_ASSERT(cvector_is_empty(&v));
+    CU_ASSERT((size_t)test_cnt == cheap_size(heap));
+    CU_ASSERT(test_cnt - 1 == cobj_int_val(cheap_peek(heap)));
+
+    /* 下标为 i 的元素的 handle 是 i */
+    for(i = 0; i < test_cnt; i += 97) {
+        CU_ASSERT((i * 7919) % test_cnt == cobj_int_val(cheap_handle_obj(heap, i)));
+    }
+    CU_ASSERT(test_cnt == test_cheap_drain(heap, -1));
+
+    cheap_free(heap);
+    cvector_release(&v);
+}
+
+void test_cheap_handle(void)
+{
+    int i = 0;
+    int test_cnt = 1000;
+    cheap *heap = cheap_new_dary(NULL, 4);
+    cheap_handle *handles = (cheap_handle*)malloc(sizeof(cheap_handle) * test_cnt);
+    cobj_int *obj = NULL;
+
+    for(i = 0; i < test_cnt; ++i) {
+        handles[i] = cheap_push(heap, cobj_int_new(i + test_cnt));
+        CU_ASSERT(CHEAP_HANDLE_NONE != handles[i]);
+    }
+
+    /* 用更小的元素替换, 比原来大时不替换 */
+    obj = cobj_int_new(test_cnt * 3);
+    CU_ASSERT(!cheap_decrease_key(heap, handles[10], obj));
+    cobj_free(obj);
+    CU_ASSERT(cheap_decrease_key(heap, handles[500], cobj_int_new(-1)));
+    CU_ASSERT(-1 == cobj_int_val(cheap_peek(heap)));
+
+    /* 直接修改元素后调整位置 */
+    obj = (cobj_int*)cheap_handle_obj(heap, handles[500]);
+    obj->val = test_cnt * 3;
+    CU_ASSERT(cheap_update(heap, handles[500]));
+    CU_ASSERT(test_cnt == cobj_int_val(cheap_peek(heap)));
+    obj = (cobj_int*)cheap_handle_obj(heap, handles[700]);
+    obj->val = -2;
+    CU_ASSERT(cheap_update(heap, handles[700]));
+    CU_ASSERT(-2 == cobj_int_val(cheap_peek(heap)));
+
+    /* 删除任意元素, 删除后 handle 无效 */
+    for(i = 0; i < test_cnt; i += 3) {
+        obj = (cobj_int*)cheap_remove(heap, handles[i]);
+        CU_ASSERT(NULL != obj);
+        cobj_free(obj);
+        CU_ASSERT(NULL == cheap_handle_obj(heap, handles[i]));
+        CU_ASSERT(NULL == cheap_remove(heap, handles[i]));
+        CU_ASSERT(!cheap_update(heap, handles[i]));
+    }
+    CU_ASSERT(NULL == cheap_handle_obj(heap, test_cnt));
+    CU_ASSERT(NULL == cheap_handle_obj(heap, CHEAP_HANDLE_NONE));
+    CU_ASSERT(test_cnt - (test_cnt + 2) / 3 == test_cheap_drain(heap, 1));
+
+    cheap_push(heap, cobj_int_new(1));
+    cheap_clear(heap);
+    CU_ASSERT(cheap_is_empty(heap));
+
+    free(handles);
+    cheap_free(heap);
+}
+
+void add_test_cheap(void)
+{
+    CU_pSuite suite = NULL;
+
+    suite = CU_add_suite("cheap", NULL, NULL);
+    CU_add_test(suite, "test_cheap", test_cheap);
+    CU_add_test(suite, "test_cheap_from_vector", test_cheap_from_vector);
+    CU_add_test(suite, "test_cheap_handle", test_cheap_handle);
+}
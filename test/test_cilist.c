@@ -0,0 +1,90 @@
+/* {{{
+ * =============================================================================
+ *      Filename    :   test_cilist.c
+ *      Description :
+ *      Created     :   2026-10-19 14:31:02
+ *      Author      :   Wu Hong
+ * =============================================================================
+ }}} */
+#include <stdlib.h>
+#include <CUnit/Console.h>
+#include "cilist.h"
+
+typedef struct test_timer
+{
+    int         id;
+    clist_link  link;
+} test_timer;
+
+void test_cilist(void)
+{
+    int i = 0;
+    int test_cnt = 100;
+    test_timer *timers = (test_timer*)calloc(test_cnt, sizeof(test_timer));
+    test_timer *timer = NULL;
+    clist_link *link  = NULL;
+    clist_link *next  = NULL;
+    cilist list;
+
+    cilist_init(&list);
+    CU_ASSERT(cilist_is_empty(&list));
+
+    for(i = 0; i < test_cnt; ++i) {
+        timers[i].id = i;
+        cilist_append(&list, &(timers[i].link));
+    }
+    CU_ASSERT(test_cnt == cilist_len(&list));
+    CU_ASSERT(&(timers[0]) == cilist_entry(cilist_first(&list), test_timer, link));
+    CU_ASSERT(&(timers[test_cnt - 1]) == cilist_entry(cilist_last(&list), test_timer, link));
+
+    i = 0;
+    cilist_foreach_entry(&list, link, timer, test_timer, link) {
+        CU_ASSERT(i == timer->id);
+        ++i;
+    }
+    CU_ASSERT(test_cnt == i);
+
+    /* 直接由元素删除, 不需要查找 */
+    cilist_remove(&list, &(timers[0].link));
+    cilist_remove(&list, &(timers[50].link));
+    cilist_remove(&list, &(timers[test_cnt - 1].link));
+    CU_ASSERT(test_cnt - 3 == cilist_len(&list));
+    CU_ASSERT(1 == cilist_entry(cilist_first(&list), test_timer, link)->id);
+    CU_ASSERT(test_cnt - 2 == cilist_entry(cilist_last(&list), test_timer, link)->id);
+
+    cilist_insert_before(&list, &(timers[51].link), &(timers[50].link));
+    cilist_insert_after(&list, NULL, &(timers[0].link));
+    cilist_insert_before(&list, NULL, &(timers[test_cnt - 1].link));
+    i = test_cnt - 1;
+    cilist_foreach_entry_tail(&list, link, timer, test_timer, link) {
+        CU_ASSERT(i == timer->id);
+        --i;
+    }
+    CU_ASSERT(-1 == i);
+
+    cilist_foreach_safe(&list, link, next) {
+        if(cilist_entry(link, test_timer, link)->id % 2) {
+            cilist_remove(&list, link);
+        }
+    }
+    CU_ASSERT(test_cnt / 2 == cilist_len(&list));
+
+    link = cilist_pop_front(&list);
+    CU_ASSERT(0 == cilist_entry(link, test_timer, link)->id);
+    link = cilist_pop_back(&list);
+    CU_ASSERT(test_cnt - 2 == cilist_entry(link, test_timer, link)->id);
+
+    cilist_clear(&list);
+    CU_ASSERT(0 == cilist_len(&list));
+    CU_ASSERT(NULL == cilist_pop_front(&list));
+
+    free(timers);
+}
+
+void add_test_cilist(void)
+{
+    CU_pSuite suite = NULL;
+
+    suite = CU_add_suite("cilist", NULL, NULL);
+    CU_add_test(suite, "test_cilist", test_cilist);
+}
@@ -0,0 +1,162 @@
+/* {{{
+ * =============================================================================
+ *      Filename    :   test_clfqueue.c
+ *      Description :
+ *      Created     :   2026-10-19 17:02:45
+ *      Author      :   Wu Hong
+ * =============================================================================
+ }}} */
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <sched.h>
+#include <CUnit/Console.h>
+#include "clfqueue.h"
+#include "cobj_int.h"
+
+#define TEST_LFQ_THREADS    4
+#define TEST_LFQ_MSGS       20000
+
+typedef struct test_lfq_ctx
+{
+    clfqueue    *queue;
+    int         batch;
+    uint64_t    sum;
+} test_lfq_ctx;
+
+static void* test_lfq_producer(void *arg)
+{
+    test_lfq_ctx *ctx = (test_lfq_ctx*)arg;
+    void *objs[8];
+    uintptr_t i = 1;
+    unsigned int j = 0;
+    unsigned int n = 0;
+
+    while(i <= TEST_LFQ_MSGS) {
+        if(ctx->batch) {
+            for(n = 0; n < 8 && i + n <= TEST_LFQ_MSGS; ++n) {
+                objs[n] = (void*)(i + n);
+            }
+            for(j = 0; j < n; ) {
+                j += clfqueue_append_batch(ctx->queue, objs + j, n - j);
+                if(j < n) sched_yield();
+            }
+            i += n;
+        } else if(clfqueue_append(ctx->queue, (void*)i)) {
+            ++i;
+        } else {
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+static void* test_lfq_consumer(void *arg)
+{
+    test_lfq_ctx *ctx = (test_lfq_ctx*)arg;
+    void *objs[8];
+    void *obj = NULL;
+    unsigned int cnt = 0;
+    unsigned int n = 0;
+
+    while(cnt < TEST_LFQ_MSGS) {
+        if(ctx->batch) {
+            n = clfqueue_pop_front_batch(ctx->queue, objs, 8);
+            if(n == 0) sched_yield();
+            cnt += n;
+            while(n) ctx->sum += (uintptr_t)objs[--n];
+        } else if((obj = clfqueue_pop_front(ctx->queue)) != NULL) {
+            ctx->sum += (uintptr_t)obj;
+            ++cnt;
+        } else {
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+void test_clfqueue(void)
+{
+    clfqueue *queue = clfqueue_new(5);
+    void *objs[16];
+    uintptr_t i = 0;
+
+    CU_ASSERT(8 == clfqueue_capacity(queue));
+    CU_ASSERT(clfqueue_is_empty(queue));
+    CU_ASSERT(NULL == clfqueue_pop_front(queue));
+
+    for(i = 1; i <= 8; ++i) {
+        CU_ASSERT(clfqueue_append(queue, (void*)i));
+    }
+    CU_ASSERT(!clfqueue_append(queue, (void*)i));
+    CU_ASSERT(8 == clfqueue_size(queue));
+
+    for(i = 1; i <= 8; ++i) {
+        CU_ASSERT((void*)i == clfqueue_pop_front(queue));
+    }
+    CU_ASSERT(NULL == clfqueue_pop_front(queue));
+
+    /* 批量操作跨过环形数组的末尾 */
+    for(i = 0; i < 16; ++i) objs[i] = (void*)(i + 1);
+    CU_ASSERT(3 == clfqueue_append_batch(queue, objs, 3));
+    CU_ASSERT(2 == clfqueue_pop_front_batch(queue, objs, 2));
+    CU_ASSERT((void*)1 == objs[0] && (void*)2 == objs[1]);
+    for(i = 0; i < 16; ++i) objs[i] = (void*)(i + 10);
+    CU_ASSERT(7 == clfqueue_append_batch(queue, objs, 16));
+    CU_ASSERT(0 == clfqueue_append_batch(queue, objs, 16));
+    CU_ASSERT(8 == clfqueue_pop_front_batch(queue, objs, 16));
+    CU_ASSERT((void*)3 == objs[0]);
+    for(i = 1; i < 8; ++i) {
+        CU_ASSERT((void*)(i + 9) == objs[i]);
+    }
+    CU_ASSERT(0 == clfqueue_pop_front_batch(queue, objs, 16));
+
+    /* 剩余的元素由 clfqueue_free 释放 */
+    clfqueue_append(queue, cobj_int_new(1));
+    clfqueue_append(queue, cobj_int_new(2));
+    clfqueue_free(queue);
+}
+
+static void test_clfqueue_threads(int batch)
+{
+    test_lfq_ctx ctx[TEST_LFQ_THREADS * 2];
+    pthread_t    tids[TEST_LFQ_THREADS * 2];
+    clfqueue     *queue = clfqueue_new(64);
+    uint64_t     sum = 0;
+    int          i = 0;
+
+    for(i = 0; i < TEST_LFQ_THREADS * 2; ++i) {
+        ctx[i].queue = queue;
+        ctx[i].batch = batch;
+        ctx[i].sum   = 0;
+        pthread_create(&tids[i], NULL,
+                       i < TEST_LFQ_THREADS ? test_lfq_producer : test_lfq_consumer,
+                       &ctx[i]);
+    }
+
+    for(i = 0; i < TEST_LFQ_THREADS * 2; ++i) {
+        pthread_join(tids[i], NULL);
+        sum += ctx[i].sum;
+    }
+
+    CU_ASSERT((uint64_t)TEST_LFQ_THREADS * TEST_LFQ_MSGS * (TEST_LFQ_MSGS + 1) / 2 == sum);
+    CU_ASSERT(clfqueue_is_empty(queue));
+    clfqueue_free(queue);
+}
+
+void test_clfqueue_mpmc(void)
+{
+    test_clfqueue_threads(0);
+    test_clfqueue_threads(1);
+}
+
+void add_test_clfqueue(void)
+{
+    CU_pSuite suite = NULL;
+
+    suite = CU_add_suite("clfqueue", NULL, NULL);
+    CU_add_test(suite, "test_clfqueue", test_clfqueue);
+    CU_add_test(suite, "test_clfqueue_mpmc", test_clfqueue_mpmc);
+}
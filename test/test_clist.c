@@ -7,6 +7,7 @@
  * =============================================================================
  }}} */
 #include <stdlib.h>
+#include <string.h>
 #include <CUnit/Console.h>
 #include "clist.h"
 #include "cobj_int.h"
@@ -73,11 +74,355 @@ void test_clist(void)
     clist_free(list);
 }
 
+void test_clist_pool(void)
+{
+    int i = 0;
+    int round = 0;
+    int test_cnt = 1000;
+    void *obj = NULL;
+    clist_pool *pool = clist_pool_new(16);
+    clist *list1 = clist_new_with_pool(pool);
+    clist *list2 = clist_new_with_pool(pool);
+    clist *list3 = clist_new_pooled();
+
+    for(round = 0; round < 3; ++round) {
+        for(i = 0; i < test_cnt; ++i) {
+            clist_append(i % 2 ? list1 : list2, cobj_int_new(i));
+            clist_prepend(list3, cobj_int_new(i));
+        }
+        CU_ASSERT(test_cnt / 2 == clist_len(list1));
+        CU_ASSERT(test_cnt / 2 == clist_len(list2));
+        CU_ASSERT(test_cnt == clist_len(list3));
+
+        for(i = 0; i < test_cnt / 2; ++i) {
+            obj = clist_pop_front(list1);
+            CU_ASSERT(i * 2 + 1 == cobj_int_val(obj));
+            cobj_free(obj);
+        }
+        CU_ASSERT(test_cnt - 1 == cobj_int_val(clist_begin_obj(list3)));
+        CU_ASSERT(0 == cobj_int_val(clist_last_obj(list3)));
+
+        clist_clear(list2);
+        clist_clear(list3);
+        CU_ASSERT(clist_is_empty(list2));
+        CU_ASSERT(clist_is_empty(list3));
+    }
+
+    clist_append(list1, cobj_int_new(1));
+    clist_append(list3, cobj_int_new(1));
+    clist_free(list1);
+    clist_free(list2);
+    clist_free(list3);
+    clist_pool_free(pool);
+}
+
+void test_clist_lock(void)
+{
+    clist_lock_type lock_type = CLIST_LOCK_NONE;
+    clist *list = NULL;
+
+    for(lock_type = CLIST_LOCK_NONE; lock_type <= CLIST_LOCK_SPIN; ++lock_type) {
+        list = clist_new_with_lock(lock_type);
+        CU_ASSERT(lock_type == clist_get_lock_type(list));
+
+        clist_lock(list);
+        clist_append(list, cobj_int_new(1));
+        if(CLIST_LOCK_NONE == lock_type) {
+            CU_ASSERT(0 == clist_lock_timed(list, 10));
+        } else {
+            /* 已被持有, 再次加锁超时 */
+            CU_ASSERT(1 == clist_lock_timed(list, 10));
+        }
+        clist_unlock(list);
+
+        CU_ASSERT(0 == clist_lock_timed(list, 10));
+        clist_unlock(list);
+
+        clist_free(list);
+    }
+
+    list = clist_new();
+    CU_ASSERT(CLIST_LOCK_MUTEX == clist_get_lock_type(list));
+    clist_set_lock_type(list, CLIST_LOCK_SPIN);
+    clist_lock(list);
+    clist_unlock(list);
+    clist_free(list);
+}
+
+static int test_clist_cmp_div(const void *obj1, const void *obj2)
+{
+    return cobj_int_val((cobj_int*)obj1) / 100000 - cobj_int_val((cobj_int*)obj2) / 100000;
+}
+
+void test_clist_sort(void)
+{
+    int i = 0;
+    int test_cnt = 10000;
+    int prev = 0;
+    int val  = 0;
+    clist_node *node = NULL;
+    void *obj = NULL;
+    clist *list  = clist_new();
+    clist *list2 = clist_new_pooled();
+
+    srand(1);
+    for(i = 0; i < test_cnt; ++i) {
+        clist_append(list, cobj_int_new((rand() % 100) * 100000 + i));
+    }
+
+    /* 按 val / 100000 排序, 相等时保持原有顺序 */
+    clist_sort_with_cb(list, test_clist_cmp_div);
+    CU_ASSERT(test_cnt == clist_len(list));
+    prev = -1;
+    clist_foreach_val(list, node, obj) {
+        val = cobj_int_val(obj);
+        CU_ASSERT(prev / 100000 <= val / 100000);
+        CU_ASSERT(prev / 100000 != val / 100000 || prev < val);
+        prev = val;
+    }
+    CU_ASSERT(NULL == list->head->prev && NULL == list->tail->next);
+    CU_ASSERT(list->tail == list->tail->prev->next);
+
+    clist_sort_desc(list);
+    prev = 100 * 100000;
+    clist_foreach_val(list, node, obj) {
+        CU_ASSERT(prev >= cobj_int_val(obj));
+        prev = cobj_int_val(obj);
+    }
+
+    clist_sort_asc(list);
+    prev = -1;
+    clist_foreach_val(list, node, obj) {
+        CU_ASSERT(prev <= cobj_int_val(obj));
+        prev = cobj_int_val(obj);
+    }
+
+    /* 合并两个有序的 list, list2 使用不同的节点分配方式 */
+    for(i = 0; i < 100; ++i) {
+        clist_append(list2, cobj_int_new(i * 100000));
+    }
+    clist_merge(list, list2, NULL);
+    CU_ASSERT(test_cnt + 100 == clist_len(list));
+    CU_ASSERT(clist_is_empty(list2));
+    prev = -1;
+    clist_foreach_val(list, node, obj) {
+        CU_ASSERT(prev <= cobj_int_val(obj));
+        prev = cobj_int_val(obj);
+    }
+    clist_free(list2);
+    clist_clear(list);
+
+    for(i = 0; i < 5; ++i) {
+        clist_append(list, cobj_int_new(i));
+    }
+    clist_move(list, 0, 4);     /* 1 2 3 4 0 */
+    CU_ASSERT(0 == cobj_int_val(clist_at_obj(list, 4)));
+    CU_ASSERT(1 == cobj_int_val(clist_at_obj(list, 0)));
+    clist_move(list, -1, 1);    /* 1 0 2 3 4 */
+    CU_ASSERT(0 == cobj_int_val(clist_at_obj(list, 1)));
+    CU_ASSERT(4 == cobj_int_val(clist_last_obj(list)));
+    clist_swap(list, 0, -1);    /* 4 0 2 3 1 */
+    CU_ASSERT(4 == cobj_int_val(clist_begin_obj(list)));
+    CU_ASSERT(1 == cobj_int_val(clist_last_obj(list)));
+    CU_ASSERT(5 == clist_len(list));
+
+    clist_free(list);
+}
+
+void test_clist_at(void)
+{
+    int i = 0;
+    int idx = 0;
+    int len = 0;
+    int test_cnt = 2000;
+    int *model = (int*)malloc(sizeof(int) * test_cnt * 2);
+    clist *list = clist_new();
+
+    /* 与数组对比随机的按下标插入, 删除和访问 */
+    srand(2);
+    for(i = 0; i < test_cnt * 2; ++i) {
+        if(len == 0 || rand() % 3) {
+            idx = rand() % (len + 1);
+            memmove(model + idx + 1, model + idx, sizeof(int) * (len - idx));
+            model[idx] = i;
+            ++len;
+            clist_insert_at(list, idx, cobj_int_new(i));
+        } else {
+            idx = rand() % len;
+            memmove(model + idx, model + idx + 1, sizeof(int) * (len - idx - 1));
+            --len;
+            if(rand() % 2) {
+                clist_remove_at(list, idx);
+            } else {
+                clist_iter iter = clist_at(list, idx);
+                clist_remove(&iter);
+            }
+        }
+
+        if(len == 0) continue;
+
+        idx = rand() % len;
+        CU_ASSERT(model[idx] == cobj_int_val(clist_at_obj(list, idx)));
+        if(i % 7 == 0) {
+            cobj_free(clist_pop_front(list));
+            memmove(model, model + 1, sizeof(int) * (--len));
+        }
+    }
+
+    CU_ASSERT(len == (int)clist_len(list));
+    for(i = 0; i < len; ++i) {
+        CU_ASSERT(model[i] == cobj_int_val(clist_at_obj(list, i)));
+    }
+    for(i = len - 1; i >= 0; i -= 3) {
+        CU_ASSERT(model[i] == cobj_int_val(clist_at_obj(list, i)));
+    }
+
+    clist_insert_at(list, -1, cobj_int_new(-1));
+    CU_ASSERT(-1 == cobj_int_val(clist_last_obj(list)));
+    clist_insert_at(list, 0, cobj_int_new(-2));
+    CU_ASSERT(-2 == cobj_int_val(clist_begin_obj(list)));
+
+    /* 64 位接口与 int 接口的下标含义相同 */
+    len += 2;
+    CU_ASSERT((size_t)len == clist_len64(list));
+    clist_insert_at64(list, -2, cobj_int_new(-3));
+    CU_ASSERT(-3 == cobj_int_val(clist_at_obj64(list, -2)));
+    CU_ASSERT(-1 == cobj_int_val(clist_at_obj64(list, len)));
+    clist_swap64(list, 0, -1);
+    CU_ASSERT(-1 == cobj_int_val(clist_at_obj64(list, 0)));
+    CU_ASSERT(-2 == cobj_int_val(clist_at_obj64(list, -1)));
+    clist_move64(list, 0, -1);
+    CU_ASSERT(-1 == cobj_int_val(clist_last_obj(list)));
+    clist_remove_at64(list, -2);
+    CU_ASSERT(-3 == cobj_int_val(clist_at_obj64(list, -2)));
+    CU_ASSERT((size_t)len == clist_len64(list));
+    CU_ASSERT(NULL == clist_at_obj64(list, len));
+    CU_ASSERT(NULL == clist_at_obj64(list, -len - 1));
+
+    clist_free(list);
+    free(model);
+}
+
+/* 按正反两个方向检查 list 的内容 */
+static bool test_clist_equal(clist *list, const int *vals, int n)
+{
+    clist_node *node = NULL;
+    int i = 0;
+
+    if(n != (int)clist_len(list)) return false;
+    clist_foreach(list, node) {
+        if(vals[i++] != cobj_int_val(node->val)) return false;
+    }
+    clist_foreach_tail(list, node) {
+        if(vals[--i] != cobj_int_val(node->val)) return false;
+    }
+
+    return true;
+}
+
+void test_clist_splice(void)
+{
+    int i = 0;
+    clist *a = clist_new();
+    clist *b = clist_new();
+    clist *c = NULL;
+    clist *pooled = clist_new_pooled();
+    clist_iter pos, first, last;
+
+    for(i = 0; i < 5; ++i) {
+        clist_append(a, cobj_int_new(i));
+        clist_append(b, cobj_int_new(i + 10));
+    }
+
+    /* [11, 13) of b before 2 of a */
+    pos   = clist_at(a, 2);
+    first = clist_at(b, 1);
+    last  = clist_at(b, 3);
+    clist_splice(a, &pos, b, &first, &last);
+    {
+        int va[] = {0, 1, 11, 12, 2, 3, 4};
+        int vb[] = {10, 13, 14};
+        CU_ASSERT(test_clist_equal(a, va, 7));
+        CU_ASSERT(test_clist_equal(b, vb, 3));
+    }
+
+    /* to the end of a, from the middle of b to its end */
+    first = clist_at(b, 1);
+    clist_splice(a, NULL, b, &first, NULL);
+    /* to the front of a, the whole b */
+    pos   = clist_begin(a);
+    first = clist_begin(b);
+    clist_splice(a, &pos, b, &first, NULL);
+    {
+        int va[] = {10, 0, 1, 11, 12, 2, 3, 4, 13, 14};
+        CU_ASSERT(test_clist_equal(a, va, 10));
+        CU_ASSERT(clist_is_empty(b));
+        CU_ASSERT(NULL == b->head && NULL == b->tail);
+    }
+
+    /* inside the same list, [2, 4) to the front */
+    pos   = clist_begin(a);
+    first = clist_at(a, 5);
+    last  = clist_at(a, 7);
+    clist_splice(a, &pos, a, &first, &last);
+    CU_ASSERT(2 == cobj_int_val(clist_at_obj(a, 0)));
+    CU_ASSERT(12 == cobj_int_val(clist_at_obj(a, 6)));
+
+    /* pos 仍指向 10 */
+    c = clist_split_at(a, &pos);
+    {
+        int va[] = {2, 3};
+        int vc[] = {10, 0, 1, 11, 12, 4, 13, 14};
+        CU_ASSERT(test_clist_equal(a, va, 2));
+        CU_ASSERT(test_clist_equal(c, vc, 8));
+    }
+    clist_concat(a, c);
+    CU_ASSERT(10 == clist_len(a));
+    CU_ASSERT(clist_is_empty(c));
+    clist_free(c);
+
+    pos = clist_end(a);
+    c = clist_split_at(a, &pos);
+    CU_ASSERT(clist_is_empty(c) && 10 == clist_len(a));
+    clist_free(c);
+
+    /* 不同的 pool 之间会重新分配节点 */
+    clist_concat(pooled, a);
+    CU_ASSERT(10 == clist_len(pooled) && clist_is_empty(a));
+    first = clist_at(pooled, 2);
+    last  = clist_at(pooled, 4);
+    clist_splice(a, NULL, pooled, &first, &last);
+    {
+        int va[] = {10, 0};
+        CU_ASSERT(test_clist_equal(a, va, 2));
+        CU_ASSERT(8 == clist_len(pooled));
+    }
+    first = clist_begin(pooled);
+    c = clist_split_at(pooled, &first);
+    {
+        int vc[] = {2, 3, 1, 11, 12, 4, 13, 14};
+        CU_ASSERT(clist_is_empty(pooled));
+        CU_ASSERT(test_clist_equal(c, vc, 8));
+    }
+    clist_concat(c, a);
+    CU_ASSERT(0 == cobj_int_val(clist_last_obj(c)));
+
+    clist_free(a);
+    clist_free(b);
+    clist_free(c);
+    clist_free(pooled);
+}
+
 void add_test_clist(void)
 {
     CU_pSuite suite = NULL;
 
     suite = CU_add_suite("clist", NULL, NULL);
     CU_add_test(suite, "test_clist", test_clist);
+    CU_add_test(suite, "test_clist_pool", test_clist_pool);
+    CU_add_test(suite, "test_clist_lock", test_clist_lock);
+    CU_add_test(suite, "test_clist_sort", test_clist_sort);
+    CU_add_test(suite, "test_clist_at", test_clist_at);
+    CU_add_test(suite, "test_clist_splice", test_clist_splice);
 }
 
@@ -0,0 +1,107 @@
+/* {{{
+ * =============================================================================
+ *      Filename    :   test_cset.c
+ *      Description :
+ *      Created     :   2026-10-19 18:44:09
+ *      Author      :   Wu Hong
+ * =============================================================================
+ }}} */
+#include <stdlib.h>
+#include <CUnit/Console.h>
+#include "cset.h"
+#include "cobj_int.h"
+
+static cobj_int* test_cset_probe(cobj_int *probe, int val)
+{
+    cobj_free(probe);
+
+    return cobj_int_new(val);
+}
+
+void test_cset(void)
+{
+    int i = 0;
+    int test_cnt = 10000;
+    cset *set = cset_new();
+    cobj_int *probe = cobj_int_new(0);
+    cobj_int *dup = cobj_int_new(1);
+    clist_iter iter;
+    void *obj = NULL;
+
+    CU_ASSERT(cset_is_empty(set));
+    for(i = 0; i < test_cnt; ++i) {
+        CU_ASSERT(cset_append(set, cobj_int_new(i)));
+    }
+    CU_ASSERT(test_cnt == cset_len(set));
+
+    /* 重复的元素不会加入 */
+    CU_ASSERT(!cset_append(set, dup));
+    CU_ASSERT(!cset_prepend(set, dup));
+    CU_ASSERT(test_cnt == cset_len(set));
+    cobj_free(dup);
+
+    for(i = 0; i < test_cnt; ++i) {
+        probe = test_cset_probe(probe, i);
+        CU_ASSERT(cset_contains(set, probe));
+        CU_ASSERT(i == cobj_int_val(cset_find_obj(set, probe)));
+    }
+    probe = test_cset_probe(probe, test_cnt);
+    CU_ASSERT(!cset_contains(set, probe));
+    CU_ASSERT(NULL == cset_find_obj(set, probe));
+    iter = cset_find(set, probe);
+    CU_ASSERT(clist_iter_is_end(&iter));
+
+    /* 删除奇数, 保持插入顺序 */
+    for(i = 1; i < test_cnt; i += 2) {
+        probe = test_cset_probe(probe, i);
+        CU_ASSERT(cset_remove(set, probe));
+        CU_ASSERT(!cset_remove(set, probe));
+    }
+    CU_ASSERT(test_cnt / 2 == cset_len(set));
+
+    i = 0;
+    iter = cset_begin(set);
+    clist_iter_foreach_obj(&iter, obj) {
+        CU_ASSERT(i == cobj_int_val(obj));
+        i += 2;
+    }
+
+    probe = test_cset_probe(probe, 100);
+    iter = cset_find(set, probe);
+    clist_iter_to_next(&iter);
+    CU_ASSERT(102 == cobj_int_val(clist_iter_obj(&iter)));
+
+    obj = cset_take(set, probe);
+    CU_ASSERT(100 == cobj_int_val(obj));
+    CU_ASSERT(!cset_contains(set, probe));
+    CU_ASSERT(cset_prepend(set, obj));
+    CU_ASSERT(100 == cobj_int_val(cset_begin_obj(set)));
+
+    obj = cset_pop_front(set);
+    CU_ASSERT(100 == cobj_int_val(obj));
+    cobj_free(obj);
+    obj = cset_pop_back(set);
+    CU_ASSERT(test_cnt - 2 == cobj_int_val(obj));
+    CU_ASSERT(!cset_contains(set, obj));
+    cobj_free(obj);
+    CU_ASSERT(test_cnt / 2 - 2 == cset_len(set));
+
+    cset_clear(set);
+    CU_ASSERT(cset_is_empty(set));
+    probe = test_cset_probe(probe, 0);
+    CU_ASSERT(!cset_contains(set, probe));
+    CU_ASSERT(NULL == cset_pop_front(set));
+    CU_ASSERT(cset_append(set, cobj_int_new(0)));
+    CU_ASSERT(cset_contains(set, probe));
+
+    cobj_free(probe);
+    cset_free(set);
+}
+
+void add_test_cset(void)
+{
+    CU_pSuite suite = NULL;
+
+    suite = CU_add_suite("cset", NULL, NULL);
+    CU_add_test(suite, "test_cset", test_cset);
+}
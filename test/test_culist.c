@@ -0,0 +1,95 @@
+/* {{{
+ * =============================================================================
+ *      Filename    :   test_culist.c
+ *      Description :
+ *      Created     :   2026-10-19 15:40:18
+ *      Author      :   Wu Hong
+ * =============================================================================
+ }}} */
+#include <stdlib.h>
+#include <CUnit/Console.h>
+#include "culist.h"
+#include "cobj_int.h"
+
+void test_culist(void)
+{
+    int i = 0;
+    int test_cnt = 1000;
+    unsigned int idx = 0;
+    void *obj = NULL;
+    culist_node *node = NULL;
+    culist_iter iter;
+    culist *list = culist_new();
+
+    CU_ASSERT(culist_is_empty(list));
+    for(i = 0; i < test_cnt; ++i) {
+        culist_append(list, cobj_int_new(i));
+    }
+    CU_ASSERT(test_cnt == culist_len(list));
+    CU_ASSERT(0 == cobj_int_val(culist_at_obj(list, 0)));
+    CU_ASSERT(500 == cobj_int_val(culist_at_obj(list, 500)));
+    CU_ASSERT(test_cnt - 1 == cobj_int_val(culist_at_obj(list, -1)));
+    CU_ASSERT(NULL == culist_at_obj(list, test_cnt));
+
+    i = 0;
+    culist_foreach_val(list, node, idx, obj) {
+        CU_ASSERT(i == cobj_int_val(obj));
+        ++i;
+    }
+    CU_ASSERT(test_cnt == i);
+
+    iter = culist_rbegin(list);
+    i = test_cnt - 1;
+    culist_iter_foreach_obj(&iter, obj) {
+        CU_ASSERT(i == cobj_int_val(obj));
+        --i;
+    }
+    CU_ASSERT(-1 == i);
+
+    /* 作为队列使用 */
+    for(i = 0; i < test_cnt; ++i) {
+        obj = culist_pop_front(list);
+        CU_ASSERT(i == cobj_int_val(obj));
+        cobj_free(obj);
+        culist_append(list, cobj_int_new(i + test_cnt));
+    }
+    CU_ASSERT(test_cnt == culist_len(list));
+    CU_ASSERT(test_cnt == cobj_int_val(culist_begin_obj(list)));
+    CU_ASSERT(test_cnt * 2 - 1 == cobj_int_val(culist_last_obj(list)));
+    culist_clear(list);
+    CU_ASSERT(culist_is_empty(list));
+
+    for(i = 0; i < test_cnt; ++i) {
+        culist_prepend(list, cobj_int_new(i));
+    }
+    iter = culist_begin(list);
+    i = test_cnt - 1;
+    culist_iter_foreach_obj(&iter, obj) {
+        CU_ASSERT(i == cobj_int_val(obj));
+        --i;
+    }
+
+    iter = culist_at(list, 100);
+    culist_remove(&iter);
+    CU_ASSERT(test_cnt - 1 == culist_len(list));
+    CU_ASSERT(test_cnt - 102 == cobj_int_val(culist_at_obj(list, 100)));
+
+    for(i = 0; i < test_cnt - 1; ++i) {
+        obj = culist_pop_back(list);
+        cobj_free(obj);
+    }
+    CU_ASSERT(culist_is_empty(list));
+    CU_ASSERT(NULL == culist_pop_back(list));
+    CU_ASSERT(NULL == culist_begin_obj(list));
+
+    culist_append(list, cobj_int_new(1));
+    culist_free(list);
+}
+
+void add_test_culist(void)
+{
+    CU_pSuite suite = NULL;
+
+    suite = CU_add_suite("culist", NULL, NULL);
+    CU_add_test(suite, "test_culist", test_culist);
+}
@@ -6,10 +6,14 @@
  *      Author      :   Wu Hong
  * =============================================================================
  }}} */
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
 #include "CUnit/Console.h"
 #include "cobj_int.h"
 #include "cobj_str.h"
 #include "cvector.h"
+#include "csort.h"
 
 void test_cvector(void)
 {
@@ -54,6 +58,356 @@ void test_cvector(void)
     cvector_free(v);
 }
 
+void test_cvector_capacity(void)
+{
+    cvector v;
+    cvector *pv = cvector_new_with_capacity(0);
+    int test_cnt = 1 << 20;     /* 超过 mmap 的阈值 */
+    int i = 0;
+
+    CU_ASSERT(CVECTOR_INLINE_SIZE == cvector_capacity(pv));
+    CU_ASSERT(pv->objs == pv->inline_objs);
+    for(i = 0; i < CVECTOR_INLINE_SIZE + 1; ++i) {
+        cvector_append(pv, cobj_int_new(i));
+    }
+    CU_ASSERT(pv->objs != pv->inline_objs);
+    cobj_free(cvector_pop_back(pv));
+    cvector_shrink_to_fit(pv);
+    CU_ASSERT(pv->objs == pv->inline_objs);
+    for(i = 0; i < CVECTOR_INLINE_SIZE; ++i) {
+        CU_ASSERT(i == cobj_int_val(cvector_at(pv, i)));
+    }
+    cvector_free(pv);
+
+    /* 内嵌数组, 不分配内存 */
+    cvector_init(&v);
+    CU_ASSERT(v.objs == v.inline_objs);
+    cvector_release(&v);
+
+    cvector_init(&v);
+    CU_ASSERT(cvector_reserve(&v, 100));
+    CU_ASSERT(100 == cvector_capacity(&v));
+    CU_ASSERT(cvector_reserve(&v, 10));
+    CU_ASSERT(100 == cvector_capacity(&v));
+
+    cvector_set_growth(&v, CVECTOR_GROWTH_HALF);
+    for(i = 0; i < 101; ++i) {
+        cvector_append(&v, cobj_int_new(i));
+    }
+    CU_ASSERT(150 == cvector_capacity(&v));
+
+    cvector_set_growth(&v, CVECTOR_GROWTH_DOUBLE);
+    for(i = 101; i < test_cnt; ++i) {
+        cvector_append(&v, cobj_int_new(i));
+    }
+    CU_ASSERT(v.mapped);
+    cvector_set_growth(&v, CVECTOR_GROWTH_EXACT);
+    cvector_append(&v, cobj_int_new(test_cnt));
+    cvector_shrink_to_fit(&v);
+    CU_ASSERT(test_cnt + 1 == (int)cvector_capacity(&v));
+
+    /* 缩小到 mmap 阈值以下后回到 malloc */
+    cvector_remove_at_range(&v, 100, test_cnt + 1);
+    cvector_shrink_to_fit(&v);
+    CU_ASSERT(!v.mapped);
+    CU_ASSERT(100 == cvector_capacity(&v));
+    for(i = 0; i < 100; ++i) {
+        CU_ASSERT(i == cobj_int_val(cvector_at(&v, i)));
+    }
+
+    cvector_release(&v);
+    CU_ASSERT(CVECTOR_INLINE_SIZE == cvector_capacity(&v));
+    CU_ASSERT(v.objs == v.inline_objs);
+}
+
+void test_cvector_64(void)
+{
+    cvector v;
+    void *objs[4] = { NULL };
+    ssize_t i = 0;
+    size_t n = 10;
+
+    cvector_init(&v);
+    for(i = 0; i < (ssize_t)n; ++i) {
+        cvector_append(&v, cobj_int_new(i * 2));
+    }
+    CU_ASSERT(n == cvector_size64(&v));
+
+    /* 超出上限的增长在分配之前失败, vector 保持不变 */
+    CU_ASSERT(!cvector_reserve(&v, SIZE_MAX));
+    CU_ASSERT(!cvector_reserve(&v, (size_t)PTRDIFF_MAX / sizeof(void*) + 1));
+    cvector_append_array64(&v, objs, SIZE_MAX);
+    cvector_insert_range64(&v, 0, objs, SIZE_MAX - n + 1);
+    CU_ASSERT(n == cvector_size64(&v));
+    CU_ASSERT(16 == cvector_capacity(&v));
+    CU_ASSERT(0 == cobj_int_val(cvector_at64(&v, 0)));
+
+    cvector_insert64(&v, -1, cobj_int_new(-1));
+    CU_ASSERT(-1 == cobj_int_val(cvector_at64(&v, (ssize_t)n - 1)));
+    cobj_free(cvector_pop_at64(&v, (ssize_t)n - 1));
+    CU_ASSERT(NULL == cvector_at64(&v, (ssize_t)n));
+    CU_ASSERT(NULL == cvector_at64(&v, -1));
+
+    objs[0] = cobj_int_new(5);
+    CU_ASSERT(3 == cvector_lower_bound64(&v, objs[0], NULL));
+    CU_ASSERT(3 == cvector_upper_bound64(&v, objs[0], NULL));
+    CU_ASSERT(-1 == cvector_bsearch64(&v, objs[0], NULL));
+    cvector_replace64(&v, 3, objs[0]);
+    CU_ASSERT(3 == cvector_bsearch64(&v, objs[0], NULL));
+    /* 用同一个对象替换时不释放 */
+    cvector_replace64(&v, 3, cvector_at64(&v, 3));
+    CU_ASSERT(5 == cobj_int_val(cvector_at64(&v, 3)));
+
+    cvector_remove_at_range64(&v, 8, 100);
+    CU_ASSERT(8 == cvector_size64(&v));
+    cvector_remove_at64(&v, 0);
+    CU_ASSERT(5 == cobj_int_val(cvector_at64(&v, 2)));
+    CU_ASSERT(7 == cvector_size64(&v));
+
+    cvector_release(&v);
+}
+
+void test_cvector_bulk(void)
+{
+    cvector *v = cvector_new();
+    cvector *other = cvector_new();
+    void *objs[100];
+    int i = 0;
+
+    for(i = 0; i < 100; ++i) {
+        objs[i] = cobj_int_new(i + 100);
+    }
+    cvector_append_array(v, objs, 100);
+    for(i = 0; i < 50; ++i) {
+        objs[i] = cobj_int_new(i);
+    }
+    cvector_insert_range(v, 0, objs, 50);
+    for(i = 0; i < 50; ++i) {
+        objs[i] = cobj_int_new(i + 50);
+    }
+    cvector_insert_range(v, 50, objs, 50);
+    CU_ASSERT(200 == cvector_size(v));
+    for(i = 0; i < 200; ++i) {
+        CU_ASSERT(i == cobj_int_val(cvector_at(v, i)));
+    }
+
+    /* 负数的下标从末尾开始 */
+    cvector_insert(v, -1, cobj_int_new(-1));
+    CU_ASSERT(-1 == cobj_int_val(cvector_at(v, 199)));
+    cvector_remove_at(v, 199);
+    CU_ASSERT(199 == cobj_int_val(cvector_at(v, 199)));
+
+    for(i = 0; i < 10; ++i) {
+        cvector_append(other, cobj_int_new(1000 + i));
+    }
+    /* other 的 [2, 5) 移到 v 的 10 处 */
+    cvector_splice(v, 10, other, 2, 5);
+    CU_ASSERT(203 == cvector_size(v));
+    CU_ASSERT(7 == cvector_size(other));
+    CU_ASSERT(9 == cobj_int_val(cvector_at(v, 9)));
+    CU_ASSERT(1002 == cobj_int_val(cvector_at(v, 10)));
+    CU_ASSERT(1004 == cobj_int_val(cvector_at(v, 12)));
+    CU_ASSERT(10 == cobj_int_val(cvector_at(v, 13)));
+    CU_ASSERT(1001 == cobj_int_val(cvector_at(other, 1)));
+    CU_ASSERT(1005 == cobj_int_val(cvector_at(other, 2)));
+
+    cvector_extend(v, other);
+    CU_ASSERT(210 == cvector_size(v));
+    CU_ASSERT(cvector_is_empty(other));
+    CU_ASSERT(1000 == cobj_int_val(cvector_at(v, 203)));
+    CU_ASSERT(1009 == cobj_int_val(cvector_at_last(v)));
+
+    cvector_remove_at_range(v, 0, 13);
+    CU_ASSERT(10 == cobj_int_val(cvector_at_first(v)));
+    cobj_free(cvector_pop_at(v, 0));
+    CU_ASSERT(11 == cobj_int_val(cvector_at_first(v)));
+    CU_ASSERT(NULL == cvector_pop_at(v, cvector_size(v)));
+
+    cvector_free(v);
+    cvector_free(other);
+}
+
+/* 只比较 val / 100000, 用于检查稳定性 */
+static int test_cvector_cmp_key(const void *obj1, const void *obj2)
+{
+    int key1 = cobj_int_val((cobj_int*)obj1) / 100000;
+    int key2 = cobj_int_val((cobj_int*)obj2) / 100000;
+
+    return key1 < key2 ? -1 : key1 > key2;
+}
+
+static bool test_cvector_is_sorted(cvector *v, cobj_cb_cmp cmp)
+{
+    int i = 0;
+
+    for(i = 1; i < cvector_size(v); ++i) {
+        if(cmp(cvector_at(v, i), cvector_at(v, i - 1)) < 0) return false;
+    }
+
+    return true;
+}
+
+static int64_t test_cvector_sum(cvector *v)
+{
+    int64_t sum = 0;
+    int i = 0;
+
+    for(i = 0; i < cvector_size(v); ++i) {
+        sum += cobj_int_val(cvector_at(v, i));
+    }
+
+    return sum;
+}
+
+void test_cvector_sort(void)
+{
+    cvector *v = cvector_new();
+    cobj_int *key = NULL;
+    int64_t sum = 0;
+    int sizes[] = {0, 1, 2, 23, 24, 129, 1000, 100000};
+    int pattern = 0;
+    int n = 0;
+    int i = 0;
+    int j = 0;
+
+    srand(3);
+    for(j = 0; j < (int)(sizeof(sizes) / sizeof(sizes[0])); ++j) {
+        n = sizes[j];
+        /* 随机, 有序, 逆序, 大量重复, 先增后减 */
+        for(pattern = 0; pattern < 5; ++pattern) {
+            cvector_clear(v);
+            for(i = 0; i < n; ++i) {
+                switch(pattern) {
+                    case 0: cvector_append(v, cobj_int_new(rand())); break;
+                    case 1: cvector_append(v, cobj_int_new(i)); break;
+                    case 2: cvector_append(v, cobj_int_new(n - i)); break;
+                    case 3: cvector_append(v, cobj_int_new(rand() % 4)); break;
+                    default: cvector_append(v, cobj_int_new(i < n / 2 ? i : n - i)); break;
+                }
+            }
+            sum = test_cvector_sum(v);
+
+            if(pattern % 2) {
+                cvector_sort(v, NULL);
+            } else {
+                cvector_sort_parallel(v, NULL, 4);
+            }
+            CU_ASSERT(n == cvector_size(v));
+            CU_ASSERT(sum == test_cvector_sum(v));
+            CU_ASSERT(test_cvector_is_sorted(v, cobj_cmp));
+        }
+    }
+
+    /* 稳定排序: key 相同的元素保持原来的顺序 */
+    cvector_clear(v);
+    for(i = 0; i < 10000; ++i) {
+        cvector_append(v, cobj_int_new(rand() % 100 * 100000 + i));
+    }
+    cvector_stable_sort(v, test_cvector_cmp_key);
+    CU_ASSERT(test_cvector_is_sorted(v, test_cvector_cmp_key));
+    CU_ASSERT(test_cvector_is_sorted(v, cobj_cmp));
+
+    /* 二分查找, 0 2 4 ... 每个值重复 3 次 */
+    cvector_clear(v);
+    for(i = 0; i < 300; ++i) {
+        cvector_append(v, cobj_int_new(i / 3 * 2));
+    }
+    for(i = -1; i < 201; ++i) {
+        key = cobj_int_new(i);
+        if(i >= 0 && i < 200 && i % 2 == 0) {
+            CU_ASSERT(i / 2 * 3 == cvector_lower_bound(v, key, NULL));
+            CU_ASSERT(i / 2 * 3 + 3 == cvector_upper_bound(v, key, NULL));
+            CU_ASSERT(i == cobj_int_val(cvector_at(v, cvector_bsearch(v, key, NULL))));
+        } else {
+            CU_ASSERT(cvector_lower_bound(v, key, NULL) == cvector_upper_bound(v, key, NULL));
+            CU_ASSERT(-1 == cvector_bsearch(v, key, NULL));
+        }
+        cobj_free(key);
+    }
+
+    cvector_free(v);
+}
+
+static int test_cvector_cmp_str(const void *obj1, const void *obj2)
+{
+    return strcmp(cobj_str_val((cobj_str*)obj1), cobj_str_val((cobj_str*)obj2));
+}
+
+void test_cvector_radix(void)
+{
+    csort_radix *ctx = csort_radix_new();
+    cvector *v = cvector_new();
+    uint64_t keys[1000];
+    char str[32];
+    int64_t sum = 0;
+    int test_cnt = 50000;
+    int round = 0;
+    int i = 0;
+    int j = 0;
+
+    srand(4);
+    /* 同一个 ctx 复用两次 */
+    for(round = 0; round < 2; ++round) {
+        cvector_clear(v);
+        for(i = 0; i < test_cnt; ++i) {
+            /* 包括负数, 第二轮只有低字节不同 */
+            cvector_append(v, cobj_int_new(round ? rand() % 256 : rand() - RAND_MAX / 2));
+        }
+        sum = test_cvector_sum(v);
+        CU_ASSERT(csort_radix_sort(ctx, v->objs, cvector_size(v), csort_key_cobj_int));
+        CU_ASSERT(sum == test_cvector_sum(v));
+        CU_ASSERT(test_cvector_is_sorted(v, cobj_cmp));
+    }
+
+    /* 稳定性 */
+    cvector_clear(v);
+    for(i = 0; i < test_cnt; ++i) {
+        cvector_append(v, cobj_int_new(rand() % 100 * 100000 + i));
+    }
+    CU_ASSERT(csort_radix_sort(NULL, v->objs, cvector_size(v), csort_key_cobj_int));
+    CU_ASSERT(test_cvector_is_sorted(v, cobj_cmp));
+
+    for(i = 0; i < 1000; ++i) {
+        keys[i] = ((uint64_t)rand() << 40) ^ (uint64_t)rand();
+    }
+    CU_ASSERT(csort_radix_sort_u64(ctx, keys, 1000));
+    for(i = 1; i < 1000; ++i) {
+        CU_ASSERT(keys[i - 1] <= keys[i]);
+    }
+
+    /* 字符串: 不同长度, 公共前缀, 重复和空串 */
+    cvector_clear(v);
+    for(i = 0; i < test_cnt; ++i) {
+        switch(i % 4) {
+            case 0:
+                snprintf(str, sizeof(str), "%d", rand() % 100000);
+                break;
+            case 1:
+                snprintf(str, sizeof(str), "prefix/common/%d", rand() % 1000);
+                break;
+            case 2:
+                for(j = 0; j < rand() % 8; ++j) {
+                    str[j] = 'a' + rand() % 3;
+                }
+                str[j] = '\0';
+                break;
+            default:
+                snprintf(str, sizeof(str), "%c%c", 0x80 + rand() % 0x7f, 'a' + rand() % 26);
+                break;
+        }
+        cvector_append(v, cobj_str_new(str));
+    }
+    for(round = 0; round < 2; ++round) {
+        CU_ASSERT(csort_radix_sort_str(round ? NULL : ctx, v->objs, cvector_size(v),
+                                       csort_str_cobj_str));
+        CU_ASSERT(cvector_size(v) == test_cnt);
+        CU_ASSERT(test_cvector_is_sorted(v, test_cvector_cmp_str));
+    }
+
+    cvector_free(v);
+    csort_radix_free(ctx);
+}
+
 void add_test_cvector(void)
 {
     CU_pSuite pSuite = NULL;
@@ -61,6 +415,11 @@ void add_test_cvector(void)
 	pSuite = CU_add_suite("test_cvector", NULL, NULL);
 
     CU_add_test(pSuite, "test_cvector", test_cvector);
+    CU_add_test(pSuite, "test_cvector_capacity", test_cvector_capacity);
+    CU_add_test(pSuite, "test_cvector_64", test_cvector_64);
+    CU_add_test(pSuite, "test_cvector_bulk", test_cvector_bulk);
+    CU_add_test(pSuite, "test_cvector_sort", test_cvector_sort);
+    CU_add_test(pSuite, "test_cvector_radix", test_cvector_radix);
 }
 
 
@@ -12,6 +12,15 @@
 extern void add_test_clist(void);
 extern void add_test_chash(void);
 extern void add_test_cvector(void);
+extern void add_test_cilist(void);
+extern void add_test_culist(void);
+extern void add_test_clfqueue(void);
+extern void add_test_cbqueue(void);
+extern void add_test_cset(void);
+extern void add_test_cdeque(void);
+extern void add_test_carray(void);
+extern void add_test_cheap(void);
+extern void add_test_cflatmap(void);
 
 int main(int argc, char *argv[])
 {
@@ -22,6 +31,15 @@ int main(int argc, char *argv[])
     add_test_clist();
     add_test_chash();
     add_test_cvector();
+    add_test_cilist();
+    add_test_culist();
+    add_test_clfqueue();
+    add_test_cbqueue();
+    add_test_cset();
+    add_test_cdeque();
+    add_test_carray();
+    add_test_cheap();
+    add_test_cflatmap();
 
     CU_basic_set_mode(mode);
 